@@ -60,6 +60,7 @@ DatabaseHandler *handler();
 //%include <src/Tcl/Swig/std_unique_ptr.i>
 %include <std_vector.i>
 %template(psn_vector_str) std::vector<std::string>;
+%template(psn_vector_float) std::vector<float>;
 %typemap(in) char ** {
      Tcl_Obj **listobjv;
      int       nitems;
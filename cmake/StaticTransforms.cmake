@@ -0,0 +1,63 @@
+# BSD 3-Clause License
+
+# Copyright (c) 2019, SCALE Lab, Brown University
+# All rights reserved.
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+
+# * Redistributions of source code must retain the above copyright notice, this
+#   list of conditions and the following disclaimer.
+
+# * Redistributions in binary form must reproduce the above copyright notice,
+#   this list of conditions and the following disclaimer in the documentation
+#   and/or other materials provided with the distribution.
+
+# * Neither the name of the copyright holder nor the names of its
+#   contributors may be used to endorse or promote products derived from
+#   this software without specific prior written permission.
+
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Compiles the enabled standard transforms into the OpenPhySyn sources instead
+# of building them as plugins. Each transform is registered through the
+# generated StaticTransforms.inc, which src/Transform/StaticTransforms.cpp
+# expands into the list returned by psn::staticTransforms().
+
+set(PSN_STATIC_TRANSFORMS_LIST "")
+
+macro(PSN_STATIC_TRANSFORM enabled transform)
+  if (${enabled})
+    set(PSN_SOURCES_NO_MAIN_NO_WRAP
+      ${PSN_SOURCES_NO_MAIN_NO_WRAP}
+      ${PSN_HOME}/src/StandardTransforms/${transform}/src/${transform}.cpp
+    )
+    set(PSN_STATIC_TRANSFORMS_LIST
+      "${PSN_STATIC_TRANSFORMS_LIST}PSN_STATIC_TRANSFORM(${transform})\n"
+    )
+  endif()
+endmacro()
+
+PSN_STATIC_TRANSFORM(OPENPHYSYN_TRANSFORM_HELLO_TRANSFORM_ENABLED HelloTransform)
+PSN_STATIC_TRANSFORM(OPENPHYSYN_TRANSFORM_BUFFER_FANOUT_ENABLED BufferFanoutTransform)
+PSN_STATIC_TRANSFORM(OPENPHYSYN_TRANSFORM_GATE_CLONE_ENABLED GateCloningTransform)
+PSN_STATIC_TRANSFORM(OPENPHYSYN_TRANSFORM_PIN_SWAP_ENABLED PinSwapTransform)
+PSN_STATIC_TRANSFORM(OPENPHYSYN_TRANSFORM_CONSTANT_PROPAGATION_ENABLED ConstantPropagationTransform)
+PSN_STATIC_TRANSFORM(OPENPHYSYN_TRANSFORM_TIMING_BUFFER_ENABLED TimingBufferTransform)
+PSN_STATIC_TRANSFORM(OPENPHYSYN_TRANSFORM_REPAIR_TIMING_ENABLED RepairTimingTransform)
+
+add_definitions(-DOPENPHYSYN_STATIC_TRANSFORMS_ENABLED)
+
+configure_file (
+  "${PROJECT_SOURCE_DIR}/cmake/StaticTransforms.inc.in"
+  "${PROJECT_BINARY_DIR}/StaticTransforms.inc"
+)
@@ -37,6 +37,13 @@
 #include <math.h>
 #include <string>
 #include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "flute.h"
 
 namespace Flute {
@@ -228,6 +235,9 @@ void readLUT() {
   initLUT(LUT_, numsoln_);
   checkLUT(LUT, numsoln, LUT_, numsoln_);
 #endif
+  // Parse the highest degrees now instead of on first use, so flute() only
+  // reads the tables and can be called from several threads.
+  readLUT9(LUT, numsoln, FLUTE_D);
 }
 
 static void
@@ -237,7 +247,7 @@ makeLUT(LUT_TYPE &LUT,
   LUT = new struct csoln **[FLUTE_D + 1];
   numsoln = new int*[FLUTE_D + 1];
   for (int d = 4; d <= FLUTE_D; d++) {
-    LUT[d] = new struct csoln *[MGROUP];
+    LUT[d] = new struct csoln *[MGROUP]();
     numsoln[d] = new int[MGROUP];
   }
 }
@@ -441,6 +451,183 @@ checkLUT(LUT_TYPE LUT1,
   }
 }
 
+// Binary LUT image: the header, numsoln[d][k] and the index of the first
+// solution of every group for d = 4 .. FLUTE_D, then all the solutions.
+// Groups sharing solutions keep sharing them in the image.
+struct LUTImageHeader {
+  char magic[8];
+  unsigned version;
+  unsigned degree;
+  unsigned routing;
+  unsigned soln_size;
+  unsigned groups;
+  unsigned solutions;
+  unsigned long long powv_size;
+  unsigned long long post_size;
+};
+
+static const char lut_image_magic[8] = {'F', 'L', 'U', 'T', 'E', 'L', 'U', 'T'};
+static const unsigned lut_image_version = 1;
+
+// Mapping backing the current tables when they were read from an image.
+static void *lut_image = NULL;
+static size_t lut_image_size = 0;
+
+// Frees the tables built by readLUT() or mapped by readLUTImage().
+static void
+deleteLUT() {
+  if (!LUT)
+    return;
+  if (lut_image) {
+    for (int d = 4; d <= FLUTE_D; d++)
+      delete [] LUT[d];
+    munmap(lut_image, lut_image_size);
+    lut_image = NULL;
+    lut_image_size = 0;
+  } else {
+    // Groups equivalent to an earlier group share its solutions.
+    std::set<struct csoln *> solns;
+    for (int d = 4; d <= FLUTE_D; d++)
+      solns.insert(LUT[d], LUT[d] + MGROUP);
+    for (std::set<struct csoln *>::iterator itr = solns.begin();
+	 itr != solns.end(); itr++)
+      delete [] *itr;
+    for (int d = 4; d <= FLUTE_D; d++) {
+      delete [] LUT[d];
+      delete [] numsoln[d];
+    }
+  }
+  delete [] LUT;
+  delete [] numsoln;
+  LUT = NULL;
+  numsoln = NULL;
+}
+
+static void
+initLUTImageHeader(LUTImageHeader &header) {
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, lut_image_magic, sizeof(header.magic));
+  header.version = lut_image_version;
+  header.degree = FLUTE_D;
+  header.routing = FLUTE_ROUTING;
+  header.soln_size = sizeof(struct csoln);
+  for (int d = 4; d <= FLUTE_D; d++)
+    header.groups += numgrp[d];
+  header.powv_size = powv9.size();
+#if FLUTE_ROUTING == 1
+  header.post_size = post9.size();
+#endif
+}
+
+bool writeLUTImage(const char *path) {
+  if (!LUT)
+    return false;
+
+  LUTImageHeader header;
+  initLUTImageHeader(header);
+  std::vector<int> group_solns;
+  std::vector<unsigned> group_first;
+  std::vector<struct csoln> solns;
+  std::map<struct csoln *, unsigned> soln_index;
+  for (int d = 4; d <= FLUTE_D; d++) {
+    for (int k = 0; k < numgrp[d]; k++) {
+      struct csoln *p = LUT[d][k];
+      int ns = numsoln[d][k];
+      std::map<struct csoln *, unsigned>::iterator itr = soln_index.find(p);
+      if (itr == soln_index.end()) {
+	itr = soln_index.insert(std::make_pair(p, (unsigned)solns.size())).first;
+	solns.insert(solns.end(), p, p + ns);
+      }
+      group_solns.push_back(ns);
+      group_first.push_back(itr->second);
+    }
+  }
+  header.solutions = solns.size();
+
+  // Written aside and renamed so concurrent readers never map a partial image.
+  std::string tmp_path = std::string(path) + ".tmp" + std::to_string(getpid());
+  FILE *fp = fopen(tmp_path.c_str(), "wb");
+  if (fp == NULL)
+    return false;
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1
+    && fwrite(group_solns.data(), sizeof(int), group_solns.size(), fp)
+         == group_solns.size()
+    && fwrite(group_first.data(), sizeof(unsigned), group_first.size(), fp)
+         == group_first.size()
+    && fwrite(solns.data(), sizeof(struct csoln), solns.size(), fp)
+         == solns.size();
+  ok = (fclose(fp) == 0) && ok;
+  if (!ok || rename(tmp_path.c_str(), path) != 0) {
+    unlink(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool readLUTImage(const char *path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(LUTImageHeader)) {
+    close(fd);
+    return false;
+  }
+  // Shared read-only mapping, the pages are reused by every process that
+  // maps the same image.
+  void *base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return false;
+
+  LUTImageHeader expected;
+  initLUTImageHeader(expected);
+  const LUTImageHeader *header = (const LUTImageHeader *)base;
+  size_t size = sizeof(LUTImageHeader)
+    + (size_t)header->groups * (sizeof(int) + sizeof(unsigned))
+    + (size_t)header->solutions * sizeof(struct csoln);
+  if (memcmp(header->magic, expected.magic, sizeof(expected.magic)) != 0
+      || header->version != expected.version
+      || header->degree != expected.degree
+      || header->routing != expected.routing
+      || header->soln_size != expected.soln_size
+      || header->groups != expected.groups
+      || header->powv_size != expected.powv_size
+      || header->post_size != expected.post_size
+      || (size_t)st.st_size != size) {
+    munmap(base, st.st_size);
+    return false;
+  }
+  int *group_solns = (int *)(header + 1);
+  unsigned *group_first = (unsigned *)(group_solns + header->groups);
+  struct csoln *solns = (struct csoln *)(group_first + header->groups);
+  for (unsigned i = 0; i < header->groups; i++) {
+    if (group_solns[i] <= 0 || group_first[i] > header->solutions
+	|| (unsigned)group_solns[i] > header->solutions - group_first[i]) {
+      munmap(base, st.st_size);
+      return false;
+    }
+  }
+
+  // numsoln and the solutions point into the mapping, only the per-group
+  // solution pointers are allocated.
+  deleteLUT();
+  lut_image = base;
+  lut_image_size = st.st_size;
+  LUT = new struct csoln **[FLUTE_D + 1];
+  numsoln = new int*[FLUTE_D + 1];
+  for (int d = 4; d <= FLUTE_D; d++) {
+    numsoln[d] = group_solns;
+    LUT[d] = new struct csoln *[numgrp[d]];
+    for (int k = 0; k < numgrp[d]; k++)
+      LUT[d][k] = solns + group_first[k];
+    group_solns += numgrp[d];
+    group_first += numgrp[d];
+  }
+  end_read_lut = true;
+  return true;
+}
+
 /* 
    base64.cpp and base64.h
 
@@ -60,7 +60,12 @@ typedef struct {
 } Tree;
 
 // User-Callable Functions
+// Loads the LUTs for every degree; flute() is thread-safe once it returns.
 void readLUT();
+// Maps a LUT image written by writeLUTImage() instead of calling readLUT().
+bool readLUTImage(const char *path);
+// Writes the LUTs loaded by readLUT() or readLUTImage() as a binary image.
+bool writeLUTImage(const char *path);
 DTYPE flute_wl(int d, DTYPE x[], DTYPE y[], int acc);
 Tree flute(int d, DTYPE x[], DTYPE y[], int acc);
 DTYPE wirelength(Tree t);
@@ -32,10 +32,13 @@
 
 #include "OpenPhySyn/Database/Types.hpp"
 #include "OpenPhySyn/Sta/PathPoint.hpp"
+#include "OpenPhySyn/Utils/FunctionRef.hpp"
+#include "OpenPhySyn/Utils/GridIndex.hpp"
 
 #include <bitset>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -63,12 +66,14 @@ namespace psn
 class Psn;
 class SteinerTree;
 class LibraryCellMapping;
+class RowLegalizer;
 typedef int                               SteinerPoint;
 typedef std::function<bool(int)>          Legalizer;
 typedef std::function<float()>            ParasticsCallback;
 typedef std::function<bool(LibraryCell*)> DontUseCallback;
 typedef std::function<void(Net*)>         ComputeParasiticsCallback;
 typedef std::function<float()>            MaxAreaCallback;
+typedef FunctionRef<void(InstanceTerm*)>   PinVisitor;
 
 enum ElectircalViolation
 {
@@ -78,6 +83,30 @@ enum ElectircalViolation
     CapacitanceAndTransition
 };
 
+// Per-pin timing values returned by DatabaseHandler::pinTimings(), every
+// vector is indexed by the position of the pin in the queried list. Null
+// entries in the list get infinite slack and zero values.
+struct PinTimings
+{
+    std::vector<float>               slacks;
+    std::vector<float>               slews;
+    std::vector<float>               loads;
+    std::vector<float>               slew_limits;
+    std::vector<float>               capacitance_limits;
+    std::vector<ElectircalViolation> violations;
+};
+
+// Names of the netlist objects edited through the handler since the design
+// was loaded, used to write ECO files.
+struct EcoChanges
+{
+    std::set<std::string> added_instances;
+    std::set<std::string> removed_instances;
+    std::set<std::string> modified_instances;
+    std::set<std::string> modified_nets;
+    std::set<std::string> removed_nets;
+};
+
 class DatabaseHandler
 {
 
@@ -105,16 +134,42 @@ public:
     virtual Term*                      term(InstanceTerm* term) const;
     virtual Net*                       net(Term* term) const;
     virtual std::vector<InstanceTerm*> connectedPins(Net* net) const;
+    virtual void forEachPin(Net* net, PinVisitor visitor) const;
+    virtual void forEachPin(Instance* inst, PinVisitor visitor) const;
+    virtual void forEachInputPin(Instance* inst, PinVisitor visitor) const;
+    virtual void forEachOutputPin(Instance* inst, PinVisitor visitor) const;
+    virtual void forEachFanoutPin(Net* net, PinVisitor visitor,
+                                  bool include_top_level = false) const;
+    virtual void forEachConnectedPin(Net* net, PinVisitor visitor) const;
     virtual std::set<InstanceTerm*>    clockPins() const;
     virtual std::set<Net*>             clockNets() const;
     virtual Point                      location(InstanceTerm* term);
     virtual Point                      location(Instance* inst);
+    virtual std::vector<Instance*>     instancesInRegion(int x_min, int y_min,
+                                                         int x_max, int y_max);
+    virtual std::vector<Instance*>     nearestInstances(Point pt, int count);
+    virtual std::vector<InstanceTerm*> pinsInRegion(int x_min, int y_min,
+                                                    int x_max, int y_max);
+    virtual std::vector<InstanceTerm*> nearestPins(Point pt, int count);
+    virtual void                       buildSpatialIndex();
+    virtual void                       clearSpatialIndex();
     virtual float                      area(LibraryCell* cell) const;
     virtual float                      area(Instance* inst) const;
     virtual float                      area() const;
     virtual float                      power(std::vector<Instance*>& insts);
     virtual float                      power();
+    virtual float                      instancePower(Instance* inst);
+    virtual float                      cachedPower();
+    virtual void                       buildPowerCache();
+    virtual void                       clearPowerCache();
+    virtual bool                       hasPowerCache() const;
+    virtual float                      activity(InstanceTerm* term);
+    virtual const EcoChanges&          ecoChanges() const;
+    virtual void                       clearEcoChanges();
     virtual void                       setLocation(Instance* inst, Point pt);
+    // Applies a DEF placement record: orientation and status name as in DEF.
+    virtual void setPlacement(Instance* inst, Point pt, const char* orient,
+                              const char* status);
     virtual LibraryTerm*               libraryPin(InstanceTerm* term) const;
     virtual Port*                      topPort(InstanceTerm* term) const;
     virtual LibraryCell*               libraryCell(InstanceTerm* term) const;
@@ -129,6 +184,7 @@ public:
     virtual bool                       isTopLevel(InstanceTerm* term) const;
     virtual Instance*                  instance(InstanceTerm* term) const;
     virtual Instance*                  instance(const char* name) const;
+    virtual InstanceTerm*              pin(const char* name) const;
     virtual BlockTerm*                 port(const char* name) const;
     virtual float                      pinCapacitance(InstanceTerm* term) const;
     virtual float                      pinCapacitance(LibraryTerm* term) const;
@@ -148,6 +204,7 @@ public:
     virtual float capacitanceLimit(InstanceTerm* term) const;
     virtual float targetLoad(LibraryCell* cell);
     virtual float coreArea() const;
+    virtual float utilization() const;
     virtual bool  maximumUtilizationViolation() const;
     virtual void  setMaximumArea(float area);
     virtual void  setMaximumArea(MaxAreaCallback maximum_area_callback);
@@ -174,6 +231,12 @@ public:
     virtual float         portCapacitance(const LibraryTerm* port,
                                           bool               isMax = true) const;
     virtual float bufferDelay(psn::LibraryCell* buffer_cell, float load_cap);
+    // Number of active timing corners; corner indices run [0, cornerCount()).
+    virtual int   cornerCount() const;
+    virtual float cornerGateDelay(LibraryTerm* out_port, float load_cap,
+                                  int corner_index);
+    virtual float cornerBufferDelay(psn::LibraryCell* buffer_cell,
+                                    float load_cap, int corner_index);
     virtual float maxLoad(LibraryTerm* term);
     virtual Net*  net(const char* name) const;
     virtual LibraryTerm* libraryPin(const char* cell_name,
@@ -272,6 +335,24 @@ public:
     maximumTransitionViolations(float limit_scale_factor = 1.0) const;
     virtual std::vector<InstanceTerm*>
                       maximumCapacitanceViolations(float limit_scale_factor = 1.0) const;
+    virtual void      pinTimings(const std::vector<InstanceTerm*>& terms,
+                                 PinTimings&                       timings,
+                                 float limit_scale_factor = 1.0) const;
+    virtual std::vector<float>
+    worstSlacks(const std::vector<InstanceTerm*>& terms) const;
+    virtual std::vector<ElectircalViolation>
+                      electricalViolations(const std::vector<InstanceTerm*>& terms,
+                                           float limit_scale_factor = 1.0) const;
+    virtual void      buildViolationIndex(float limit_scale_factor = 1.0);
+    virtual void      updateViolationIndex();
+    virtual void      clearViolationIndex();
+    virtual bool      hasViolationIndex() const;
+    virtual ElectircalViolation indexedViolation(InstanceTerm* driver);
+    virtual float               violationSeverity(InstanceTerm* driver);
+    virtual std::vector<InstanceTerm*>
+    topViolations(int                 count = 0,
+                  ElectircalViolation type =
+                      ElectircalViolation::CapacitanceAndTransition);
     virtual bool      isLoad(InstanceTerm* term) const;
     virtual Instance* createInstance(const char* inst_name, LibraryCell* cell);
     virtual void      createClock(const char*             clock_name,
@@ -291,8 +372,8 @@ public:
                            std::string buffer_name, std::string net_name,
                            Point location);
     virtual void swapPins(InstanceTerm* first, InstanceTerm* second);
-    virtual void del(Net* net) const;
-    virtual void del(Instance* inst) const;
+    virtual void del(Net* net);
+    virtual void del(Instance* inst);
     virtual void clear();
     virtual unsigned int           fanoutCount(Net* net,
                                                bool include_top_level = false) const;
@@ -320,6 +401,8 @@ public:
     virtual float required(InstanceTerm* term) const;
     virtual float required(InstanceTerm* term, bool is_rise,
                            PathAnalysisPoint* path_ap) const;
+    virtual float cornerRequired(InstanceTerm* term, int corner_index) const;
+    virtual float cornerArrival(InstanceTerm* term, int corner_index) const;
     virtual bool isCommutative(InstanceTerm* first, InstanceTerm* second) const;
     virtual bool isCommutative(LibraryTerm* first, LibraryTerm* second) const;
     virtual bool isBuffer(LibraryCell* cell) const;
@@ -377,6 +460,7 @@ public:
     virtual void        calculateParasitics();
     virtual void        calculateParasitics(Net* net);
     virtual void        resetCache();
+    virtual void        resetNetlistCache();
     virtual void        setLegalizer(Legalizer& legalizer);
     virtual bool        legalize(int max_displacement = 0);
     virtual float bufferFixedInputSlew(LibraryCell* buffer_cell, float cap);
@@ -391,6 +475,8 @@ public:
     Vertex* vertex(InstanceTerm* term) const;
 
 private:
+    friend class RowLegalizer;
+
     std::vector<Liberty*> allLibs() const;
 
     DatabaseSta* sta_;
@@ -446,11 +532,10 @@ private:
     void computeBuffersDelayPenalty(bool include_inverting = true);
 
     /* The following code is borrowed from James Cherry's Resizer Code */
-    const sta::Corner*              corner_;
-    const sta::DcalcAnalysisPt*     dcalc_ap_;
-    const sta::Pvt*                 pvt_;
-    const sta::ParasiticAnalysisPt* parasitics_ap_;
-    float                           target_slews_[2];
+    const sta::Corner*          cmdCorner() const;
+    const sta::DcalcAnalysisPt* cmdDcalcAnalysisPt() const;
+    const sta::Pvt*             cmdPvt() const;
+    float                       target_slews_[2];
     float pinTableAverage(LibraryTerm* from, LibraryTerm* to,
                           bool is_delay = true, bool is_rise = true) const;
     float pinTableLookup(LibraryTerm* from, LibraryTerm* to, float slew,
@@ -468,6 +553,9 @@ private:
     void  findTargetLoads(std::vector<Liberty*>* resize_libs);
     void  findTargetLoads(Liberty* library, float slews[]);
     void  findTargetLoad(LibraryCell* cell, float slews[]);
+    float gateDelay(LibraryTerm* out_port, float load_cap, float* tr_slew,
+                    const sta::DcalcAnalysisPt* dcalc_ap);
+    const sta::Corner* findCorner(int corner_index) const;
     float findTargetLoad(LibraryCell* cell, sta::TimingArc* arc, float in_slew,
                          float out_slew);
     float targetSlew(const sta::RiseFall* rf);
@@ -475,17 +563,96 @@ private:
     void  findBufferTargetSlews(Liberty* library, float slews[], int counts[]);
     void  slewLimit(InstanceTerm* pin, sta::MinMax* min_max, float& limit,
                     bool& exists) const;
+    void  sortLevelDrivers() const;
+    void  updateLevelDrivers() const;
+    void  invalidateLevels(Instance* inst) const;
+    bool  evaluateViolation(InstanceTerm* driver);
+    ElectircalViolation netViolation(Net* net, float limit_scale_factor,
+                                     float* severity  = nullptr,
+                                     float* max_slew = nullptr) const;
+    void  invalidateNet(Net* net) const;
+    void  invalidatePin(InstanceTerm* term) const;
+    void  invalidateInstance(Instance* inst) const;
+    void  updatePowerCache();
+    void  updateLocations(Instance* inst);
+    void  indexInstance(Instance* inst);
+    // Move without queueing the instance for legalization.
+    void  moveInstance(Instance* inst, Point pt);
+    void  trackInstanceChange(Instance* inst);
+    void  trackNetChange(Net* net) const;
     sta::ParasiticNode* findParasiticNode(std::unique_ptr<SteinerTree>& tree,
                                           sta::Parasitic*     parasitic,
                                           const Net*          net,
                                           const InstanceTerm* pin,
                                           SteinerPoint        pt);
-    Legalizer           legalizer_;
-    ParasticsCallback   res_per_micron_callback_;
+    void makeParasiticNetwork(Net* net, std::unique_ptr<SteinerTree>& tree,
+                              const sta::ParasiticAnalysisPt* parasitics_ap);
+    Legalizer                     legalizer_;
+    std::unique_ptr<RowLegalizer> row_legalizer_;
+    ParasticsCallback             res_per_micron_callback_;
     ParasticsCallback   cap_per_micron_callback_;
     DontUseCallback     dont_use_callback_;
     ComputeParasiticsCallback compute_parasitics_callback_;
     MaxAreaCallback           maximum_area_callback_;
+
+    // Total cell area, computed once and then kept up to date by
+    // createInstance(), del() and replaceInstance().
+    mutable double design_area_;
+    mutable bool   design_area_valid_;
+
+    // Driver pins in (level, vertex id) order from the last full sort, patched
+    // with the drivers created or deleted since then. Drivers of rewired
+    // instances are queued as dirty; they and their fanout cone get their
+    // levels re-read before the next query.
+    struct LevelDriver
+    {
+        int           level;
+        unsigned int  id;
+        InstanceTerm* pin;
+    };
+    mutable std::vector<LevelDriver>          level_drivers_;
+    mutable std::unordered_set<InstanceTerm*> level_drivers_added_;
+    mutable std::unordered_set<InstanceTerm*> level_drivers_removed_;
+    mutable std::unordered_set<InstanceTerm*> level_drivers_dirty_;
+    mutable bool                              level_drivers_valid_;
+    static bool levelDriverLess(const LevelDriver& d1, const LevelDriver& d2);
+
+    // Electrical violation index, driver pin -> (severity, violation type),
+    // with a severity-ordered view for top-K queries. Nets and pins touched
+    // by edits are queued as dirty and re-evaluated lazily; a driver whose
+    // net slew changed also queues the drivers in its fanout.
+    std::unordered_map<InstanceTerm*, std::pair<float, ElectircalViolation>>
+                                              violation_index_;
+    std::unordered_map<InstanceTerm*, float>  violation_slews_;
+    std::set<std::pair<float, InstanceTerm*>> violation_order_;
+    mutable std::unordered_set<Net*>          violation_dirty_nets_;
+    mutable std::unordered_set<InstanceTerm*> violation_dirty_pins_;
+    bool                                      has_violation_index_;
+    bool                                      violation_index_stale_;
+    float                                     violation_limit_scale_factor_;
+
+    // Grid indexes over placed instance origins and pin locations, built on
+    // the first spatial query and kept up to date by setLocation(), del() and
+    // replaceInstance(). Pin locations are also cached for location(), which
+    // may be called from worker threads.
+    GridIndex<Instance*>                                  instance_index_;
+    GridIndex<InstanceTerm*>                              pin_index_;
+    bool                                                  spatial_index_valid_;
+    std::unordered_map<InstanceTerm*, std::pair<int, int>> pin_locations_;
+    std::mutex                                            pin_locations_mutex_;
+
+    // Per-instance power, built by buildPowerCache() and refreshed lazily for
+    // the instances whose cell, load or input nets were touched by edits.
+    // design_power_ is the running sum over all cached instances.
+    std::unordered_map<Instance*, float>  instance_power_;
+    mutable std::unordered_set<Net*>      power_dirty_nets_;
+    mutable std::unordered_set<Instance*> power_dirty_insts_;
+    float                                 design_power_;
+    bool                                  has_power_cache_;
+
+    // Edits since the last clearEcoChanges(), an instance deleted and
+    // recreated under the same name is reported as modified.
+    mutable EcoChanges eco_changes_;
 };
 
 } // namespace psn
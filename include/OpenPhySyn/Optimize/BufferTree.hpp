@@ -35,6 +35,7 @@
 #include "OpenPhySyn/Database/Types.hpp"
 #include "OpenPhySyn/Liberty/LibraryMapping.hpp"
 #include "OpenPhySyn/Optimize/SteinerTree.hpp"
+#include "OpenPhySyn/Utils/OptimizationBudget.hpp"
 #include "opendb/geom.h"
 
 #include <memory>
@@ -66,6 +67,10 @@ enum DesignPhase
 // Represent a single candidate buffer tree.
 class BufferTree
 {
+public:
+    static const int max_corners = 8; // Corners tracked per candidate
+
+private:
     float capacitance_;      // Tree total capacitance
     float required_or_slew_; // required time for timing-driven and slew for
                              // timerless
@@ -85,6 +90,9 @@ class BufferTree
     std::shared_ptr<LibraryCellMappingNode>
           library_mapping_node_; // Resynthesis mapping
     Point driver_location_;      // Driver cell location
+    int   corner_count_; // Tracked corners, 0 for single-corner buffering
+    float corner_required_[max_corners]; // Per-corner required time, the
+                                         // worst one is required_or_slew_
 
 public:
     BufferTree(float cap = 0.0, float req = 0.0, float cost = 0.0,
@@ -134,6 +142,23 @@ public:
     float bufferRequired(Psn* psn_inst, LibraryCell* buffer_cell) const;
     float bufferRequired(Psn* psn_inst) const;
     float upstreamBufferRequired(Psn* psn_inst) const;
+    // Worst-case required time at the driver output pin
+    float driverRequired(Psn* psn_inst, LibraryTerm* driver_pin) const;
+
+    // Multi-corner required times, offset by the per-corner arrival at the
+    // driver so that all comparisons use the corner with the least slack.
+    int   cornerCount() const;
+    float cornerRequired(int corner_index) const;
+    float totalCornerRequired(int corner_index) const;
+    void  setCornerRequired(const float* required, int corner_count);
+    // Writes the per-corner arrival at the driver inputs relative to the
+    // latest corner; returns the corner count, 0 for single-corner runs.
+    static int driverArrivalOffsets(Psn* psn_inst, InstanceTerm* driver_pin,
+                                    float* arrival_offsets);
+    void       loadCornerRequired(Psn* psn_inst, InstanceTerm* load_pin,
+                                  const float* arrival_offsets,
+                                  int          corner_count);
+    void  updateCornerRequired(Psn* psn_inst);
 
     bool hasDownstreamSlewViolation(Psn* psn_inst, float slew_limit,
                                     float tr_slew = 0.0);
@@ -220,6 +245,7 @@ public:
         legalize_eventually              = false;
         legalize_each_iteration          = false;
         current_iteration                = 0;
+        partitions                       = 1;
     }
     float initial_area;             // Area before the optimization
     int   max_iterations;           // Maximum number of optimization iterations
@@ -263,6 +289,8 @@ public:
         best_solution_threshold_range; // Number of lower cost solutions to test
     float
         minimum_upstream_resistance; // Minimum upstream resistance for pruning
+    int partitions; // Grid size for region-partitioned repair (1 = disabled)
+    OptimizationBudget budget; // Wall-clock and edit limits
 };
 
 // Represents a set of non-dominatd candidate buffer trees.
@@ -271,6 +299,19 @@ class BufferSolution
     std::vector<std::shared_ptr<BufferTree>> buffer_trees_;
     BufferMode                               mode_;
 
+    // Recursive steps; the driver arrival offsets are computed once per net.
+    static std::shared_ptr<BufferSolution>
+    bottomUp(Psn* psn_inst, InstanceTerm* driver_pin, SteinerPoint pt,
+             SteinerPoint prev, std::shared_ptr<SteinerTree> st_tree,
+             std::unique_ptr<OptimizationOptions>& options,
+             const float* arrival_offsets, int corner_count);
+    static std::shared_ptr<BufferSolution> bottomUpWithResynthesis(
+        Psn* psn_inst, InstanceTerm* driver_pin, SteinerPoint pt,
+        SteinerPoint prev, std::shared_ptr<SteinerTree> st_tree,
+        std::unique_ptr<OptimizationOptions>&                 options,
+        std::vector<std::shared_ptr<LibraryCellMappingNode>>& mapping_terminals,
+        const float* arrival_offsets, int corner_count);
+
 public:
     BufferSolution(BufferMode buffer_mode = BufferMode::TimingDriven);
     BufferSolution(Psn* psn_inst, std::shared_ptr<BufferSolution>& left,
@@ -294,15 +335,15 @@ public:
 
     // van Ginneken buffer algorithm top-down
     static void topDown(Psn* psn_inst, Net* net,
-                        std::shared_ptr<BufferTree> tree, float& area,
-                        int& net_index, int& buff_index,
+                        std::shared_ptr<BufferTree> tree, int& net_index,
+                        int& buff_index,
                         std::unordered_set<Instance*>& added_buffers,
                         std::unordered_set<Net*>&      affected_nets);
 
     // van Ginneken buffer algorithm top-down
     static void topDown(Psn* psn_inst, InstanceTerm* pin,
-                        std::shared_ptr<BufferTree> tree, float& area,
-                        int& net_index, int& buff_index,
+                        std::shared_ptr<BufferTree> tree, int& net_index,
+                        int& buff_index,
                         std::unordered_set<Instance*>& added_buffers,
                         std::unordered_set<Net*>&      affected_nets);
 
@@ -0,0 +1,108 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "OpenPhySyn/Database/Types.hpp"
+
+namespace odb
+{
+class dbRow;
+class dbInst;
+} // namespace odb
+
+namespace psn
+{
+class DatabaseHandler;
+
+// Row and site aware incremental legalizer, used when no external legalizer
+// is set. Only the instances that were moved, created or resized since the
+// last call are snapped to the nearest free site; the rest of the placement
+// is treated as legal and fixed.
+class RowLegalizer
+{
+public:
+    RowLegalizer(DatabaseHandler* handler);
+
+    // Queue an instance whose location or footprint changed.
+    void add(Instance* inst);
+    void remove(Instance* inst);
+    void reset();
+    // max_displacement is in rows, 0 searches all the rows.
+    bool legalize(int max_displacement = 0);
+    int  pendingCount() const;
+
+private:
+    struct Row
+    {
+        odb::dbRow*             row;
+        int                     x_min;
+        int                     x_max;
+        int                     y;
+        int                     height;
+        int                     pitch;
+        int                     max_width;
+        std::multimap<int, int> occupied; // x begin -> x end
+    };
+    struct Occupancy
+    {
+        int row;
+        int begin;
+        int end;
+    };
+
+    void buildRows();
+    void occupy(Instance* inst, odb::dbInst* dinst);
+    void release(Instance* inst);
+    // Rows stacked from index up to the given height, false if they do not
+    // reach it.
+    bool rowSpan(int index, int height, std::vector<int>& span) const;
+    bool overlaps(const Row& row, int x, int width, int& min_begin,
+                  int& max_end) const;
+    bool overlaps(const std::vector<int>& span, int x, int width,
+                  int& min_begin, int& max_end) const;
+    bool findSite(const std::vector<int>& span, int width, int target_x,
+                  int& x) const;
+    bool place(Instance* inst, int max_displacement);
+
+    DatabaseHandler*                                     handler_;
+    std::vector<Row>                                     rows_;
+    bool                                                 rows_valid_;
+    int                                                  max_row_height_;
+    std::vector<Instance*>                               pending_order_;
+    std::unordered_set<Instance*>                        pending_;
+    std::unordered_map<Instance*, std::vector<Occupancy>> occupancy_;
+};
+} // namespace psn
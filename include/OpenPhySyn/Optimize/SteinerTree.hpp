@@ -72,6 +72,11 @@ class SteinerTree
 public:
     static std::unique_ptr<SteinerTree> create(Net* net, Psn* psn_inst,
                                                int flute_accuracy = 3);
+    // Builds the tree over pins already collected from connectedPins(), it
+    // does not query the network names and can run on worker threads.
+    static std::unique_ptr<SteinerTree>
+    create(Net* net, const std::vector<InstanceTerm*>& pins, Psn* psn_inst,
+           int flute_accuracy = 3);
 
     DefDbu distance(SteinerPoint& from, SteinerPoint& to) const;
 
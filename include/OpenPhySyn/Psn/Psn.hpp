@@ -42,11 +42,13 @@
 #include "sta/ConcreteNetwork.hh"
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 namespace psn
 {
 typedef std::function<bool(int)> Legalizer;
+class SnapshotWriter;
 class Psn
 {
 public:
@@ -62,12 +64,27 @@ public:
     virtual int readDef(const char* path);
     virtual int readLef(const char* path, bool import_library = true,
                         bool import_tech = true);
-    virtual int readLib(const char* path);
+    virtual int readLib(const char* path, const char* cache_dir = nullptr,
+                        bool validate_cache = false);
+    virtual int readLibs(const std::vector<std::string>& paths,
+                         const char* cache_dir = nullptr,
+                         bool        validate_cache = false);
+    virtual int readLefs(const std::vector<std::string>& paths,
+                         bool import_library = true, bool import_tech = true);
 
     virtual int writeDef(const char* path);
-
-    virtual int writeDatabase(const char* path);
-    virtual int readDatabase(const char* path);
+    // Writes or applies the netlist edits made since the design was loaded.
+    virtual int writeEco(const char* path);
+    virtual int readEco(const char* path);
+    virtual int writeTimingSnapshot(const char* path);
+
+    // An asynchronous write returns once the database is serialized in
+    // memory, use waitDatabaseWrite() to block until it is on disk.
+    virtual int         writeDatabase(const char* path, bool async = false,
+                                      bool compress = false);
+    virtual int         waitDatabaseWrite();
+    virtual std::string databaseWriteStatus() const;
+    virtual int         readDatabase(const char* path);
 
     int         loadTransforms();
     bool        hasTransform(std::string transform_name);
@@ -128,13 +145,24 @@ private:
     DatabaseHandler*  db_handler_;
     std::string       exec_path_;
 
+    std::unique_ptr<SnapshotWriter> db_writer_;
+
     std::vector<psn::TransformHandler> handlers_;
 
     int initializeDatabase();
     int initializeSta(Tcl_Interp* interp = nullptr);
+    int registerTransform(const TransformInfo& info, const std::string& path,
+                          std::shared_ptr<TransformHandler> handler);
+    std::shared_ptr<PsnTransform>
+    instantiateTransform(const std::string& transform_name);
 
     std::unordered_map<std::string, std::shared_ptr<PsnTransform>> transforms_;
     std::unordered_map<std::string, TransformInfo> transforms_info_;
+    // Transforms found by loadTransforms() but not instantiated yet, with
+    // the plugin path and its handler if the plugin was already opened
+    std::unordered_map<std::string,
+                       std::pair<std::string, std::shared_ptr<TransformHandler>>>
+        pending_transforms_;
     Tcl_Interp*                                    interp_;
     ProgramOptions                                 program_options_;
     static Psn*                                    psn_instance_;
@@ -20,6 +20,8 @@
 #include "opendb/db.h"
 #include "sta/Sta.hh"
 
+#include <functional>
+
 namespace sta
 {
 
@@ -34,6 +36,9 @@ using odb::dbTech;
 class DatabaseSta : public Sta
 {
 public:
+    typedef std::function<LibertyLibrary*(const char*, bool, Network*)>
+        LibertyFileReader;
+
     DatabaseSta();
     void init(Tcl_Interp* tcl_interp, dbDatabase* db);
 
@@ -53,6 +58,10 @@ public:
                                         const MinMaxAll* min_max,
                                         bool infer_latches) override;
 
+    // Replaces the text liberty parser used by readLiberty, pass an empty
+    // function to restore the default reader.
+    void setLibertyFileReader(LibertyFileReader reader);
+
     Slack netSlack(const dbNet* net, const MinMax* min_max);
     using Sta::netSlack;
 
@@ -67,9 +76,15 @@ public:
 protected:
     virtual void makeNetwork() override;
     virtual void makeSdcNetwork() override;
+    virtual LibertyLibrary* readLibertyFile(const char* filename,
+                                            Corner*     corner,
+                                            const MinMaxAll* min_max,
+                                            bool             infer_latches,
+                                            Network* network) override;
 
     dbDatabase*         db_;
     DatabaseStaNetwork* db_network_;
+    LibertyFileReader   liberty_file_reader_;
 };
 
 DatabaseSta* makeBlockSta(dbBlock* block);
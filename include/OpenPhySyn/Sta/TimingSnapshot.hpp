@@ -0,0 +1,134 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace psn
+{
+// Columnar binary timing snapshot written by export_timing. The file holds,
+// after the header, one column per field for every pin, every endpoint and
+// every point of the endpoint worst paths, followed by the pin names:
+//
+//   pin     name offset (u32), arrival, required, slack and slew for rise
+//           and fall (f32 each)
+//   endpoint pin index (u32), worst slack (f32), first path point (u32),
+//           path length (u32)
+//   point   pin index (u32), arrival, required, slack, slew (f32), rise (u8)
+//   names   null-terminated pin path names
+//
+// Times are in seconds, unconstrained values keep STA's infinity. The
+// reader maps the file read-only and does not depend on OpenSTA.
+struct TimingSnapshotHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t pin_count;
+    uint32_t endpoint_count;
+    uint32_t point_count;
+    uint64_t names_size;
+};
+
+struct TimingSnapshotPoint
+{
+    uint32_t pin;
+    bool     is_rise;
+    float    arrival;
+    float    required;
+    float    slack;
+    float    slew;
+};
+
+class TimingSnapshot
+{
+public:
+    enum PinColumn
+    {
+        ArrivalRise,
+        ArrivalFall,
+        RequiredRise,
+        RequiredFall,
+        SlackRise,
+        SlackFall,
+        SlewRise,
+        SlewFall,
+        PinColumnCount
+    };
+    static const char     magic[8];
+    static const uint32_t version;
+
+    TimingSnapshot();
+    ~TimingSnapshot();
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    uint32_t    pinCount() const;
+    uint32_t    endpointCount() const;
+    uint32_t    pointCount() const;
+    const char* pinName(uint32_t pin) const;
+    // Returns the pin index of the given path name, or pinCount() if the pin
+    // is not in the snapshot
+    uint32_t     findPin(const std::string& name) const;
+    const float* pinColumn(PinColumn column) const;
+
+    const uint32_t* endpointPins() const;
+    const float*    endpointSlacks() const;
+    std::vector<TimingSnapshotPoint> endpointPath(uint32_t endpoint) const;
+
+    // Size in bytes of a snapshot with the given counts
+    static size_t fileSize(uint32_t pin_count, uint32_t endpoint_count,
+                           uint32_t point_count, uint64_t names_size);
+
+private:
+    void*  data_;
+    size_t size_;
+
+    const TimingSnapshotHeader* header_;
+    const uint32_t*             pin_names_;
+    const float*                pin_columns_;
+    const uint32_t*             endpoint_pins_;
+    const float*                endpoint_slacks_;
+    const uint32_t*             endpoint_path_begin_;
+    const uint32_t*             endpoint_path_size_;
+    const uint32_t*             point_pins_;
+    const float*                point_arrivals_;
+    const float*                point_requireds_;
+    const float*                point_slacks_;
+    const float*                point_slews_;
+    const uint8_t*              point_rises_;
+    const char*                 names_;
+};
+} // namespace psn
@@ -45,8 +45,40 @@ public:
     virtual ~PsnTransform();
     virtual int run(Psn* psn_, std::vector<std::string> args) = 0;
 };
+
+// Entry points of a transform linked into OpenPhySyn instead of being loaded
+// as a plugin; see OPENPHYSYN_STATIC_TRANSFORMS_ENABLED.
+struct StaticTransform
+{
+    std::shared_ptr<PsnTransform> (*load)();
+    const char* name;
+    const char* version;
+    const char* description;
+    const char* help;
+};
+
+std::vector<StaticTransform> staticTransforms();
 } // namespace psn
 
+#ifdef OPENPHYSYN_STATIC_TRANSFORMS_ENABLED
+// Statically linked transforms cannot share the plugin's C symbols, each one
+// exposes a psn::staticTransform<classType>() function instead, collected by
+// staticTransforms(). The macro must be used inside the psn namespace.
+#define DEFINE_TRANSFORM(classType, transformName, transformVersion,           \
+                         transformDescription, transformHelp)                  \
+    std::shared_ptr<psn::PsnTransform> loadStaticTransform##classType()        \
+    {                                                                          \
+        return std::make_shared<classType>();                                  \
+    }                                                                          \
+                                                                               \
+    psn::StaticTransform staticTransform##classType()                          \
+    {                                                                          \
+        psn::StaticTransform transform = {                                     \
+            &loadStaticTransform##classType, transformName, transformVersion,  \
+            transformDescription, transformHelp};                              \
+        return transform;                                                      \
+    }
+#else
 #define DEFINE_TRANSFORM(classType, transformName, transformVersion,           \
                          transformDescription, transformHelp)                  \
     extern "C"                                                                 \
@@ -79,3 +111,4 @@ public:
             return transformDescription;                                       \
         }                                                                      \
     }
+#endif
@@ -0,0 +1,80 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace psn
+{
+
+template <typename Signature>
+class FunctionRef;
+
+// Non-owning reference to a callable, passed by value in place of
+// std::function on hot paths: it never allocates and the call is a single
+// indirect jump. The referenced callable must outlive the call it is passed
+// to, which is always the case for lambdas written at the call site.
+template <typename Return, typename... Args>
+class FunctionRef<Return(Args...)>
+{
+public:
+    template <typename Callable,
+              typename = typename std::enable_if<
+                  !std::is_same<typename std::decay<Callable>::type,
+                                FunctionRef>::value>::type>
+    FunctionRef(Callable&& callable)
+        : callable_(const_cast<void*>(
+              static_cast<const void*>(std::addressof(callable)))),
+          invoke_(&invoke<typename std::remove_reference<Callable>::type>)
+    {
+    }
+
+    Return
+    operator()(Args... args) const
+    {
+        return invoke_(callable_, std::forward<Args>(args)...);
+    }
+
+private:
+    template <typename Callable>
+    static Return
+    invoke(void* callable, Args... args)
+    {
+        return (*static_cast<Callable*>(callable))(std::forward<Args>(args)...);
+    }
+
+    void* callable_;
+    Return (*invoke_)(void*, Args...);
+};
+
+} // namespace psn
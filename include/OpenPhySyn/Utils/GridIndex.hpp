@@ -0,0 +1,261 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psn
+{
+// Uniform grid of buckets over a bounding box for point objects, with
+// incremental updates, rectangle queries and k-nearest (Manhattan) queries.
+// Points outside the bounding box are clamped to the boundary buckets.
+// An object may also carry an extent around its point; it is bucketed by the
+// point and rectangle queries widen their bucket range by the largest
+// extent inserted so far, so objects overlapping the rectangle are found.
+template<typename T>
+class GridIndex
+{
+private:
+    struct Entry
+    {
+        int x;
+        int y;
+        int x_min;
+        int y_min;
+        int x_max;
+        int y_max;
+        int bin;
+        int slot;
+    };
+    int                          x_min_;
+    int                          y_min_;
+    int                          bin_size_;
+    int                          columns_;
+    int                          rows_;
+    int                          reach_;
+    std::vector<std::vector<T>>  bins_;
+    std::unordered_map<T, Entry> entries_;
+
+    int
+    column(int x) const
+    {
+        return std::min(std::max((x - x_min_) / bin_size_, 0), columns_ - 1);
+    }
+    int
+    row(int y) const
+    {
+        return std::min(std::max((y - y_min_) / bin_size_, 0), rows_ - 1);
+    }
+    void
+    collect(int col, int r, int x, int y,
+            std::vector<std::pair<long long, T>>& candidates) const
+    {
+        if (col < 0 || r < 0 || col >= columns_ || r >= rows_)
+        {
+            return;
+        }
+        for (auto& item : bins_[r * columns_ + col])
+        {
+            auto& entry = entries_.at(item);
+            candidates.push_back(std::make_pair(
+                (long long)std::abs(entry.x - x) + std::abs(entry.y - y),
+                item));
+        }
+    }
+
+public:
+    GridIndex()
+        : x_min_(0), y_min_(0), bin_size_(1), columns_(0), rows_(0), reach_(0)
+    {
+    }
+    void
+    reset(int x_min, int y_min, int x_max, int y_max, int bin_size)
+    {
+        x_min_    = x_min;
+        y_min_    = y_min;
+        bin_size_ = std::max(bin_size, 1);
+        columns_  = std::max((x_max - x_min) / bin_size_ + 1, 1);
+        rows_     = std::max((y_max - y_min) / bin_size_ + 1, 1);
+        reach_    = 0;
+        bins_.assign(columns_ * rows_, std::vector<T>());
+        entries_.clear();
+    }
+    void
+    clear()
+    {
+        bins_.clear();
+        entries_.clear();
+        columns_ = 0;
+        rows_    = 0;
+        reach_   = 0;
+    }
+    bool
+    empty() const
+    {
+        return bins_.empty();
+    }
+    size_t
+    size() const
+    {
+        return entries_.size();
+    }
+    bool
+    contains(T item) const
+    {
+        return entries_.count(item);
+    }
+    void
+    insert(T item, int x, int y)
+    {
+        insert(item, x, y, x, y, x, y);
+    }
+    // Inserts an object at (x, y) covering the box [x_min, x_max] x
+    // [y_min, y_max], which is expected to contain the point.
+    void
+    insert(T item, int x, int y, int x_min, int y_min, int x_max, int y_max)
+    {
+        if (bins_.empty())
+        {
+            return;
+        }
+        remove(item);
+        int bin = row(y) * columns_ + column(x);
+        entries_[item] = {x,     y,     x_min, y_min,
+                          x_max, y_max, bin,   (int)bins_[bin].size()};
+        bins_[bin].push_back(item);
+        reach_ = std::max(reach_, std::max(std::max(x - x_min, x_max - x),
+                                           std::max(y - y_min, y_max - y)));
+    }
+    void
+    remove(T item)
+    {
+        auto itr = entries_.find(item);
+        if (itr == entries_.end())
+        {
+            return;
+        }
+        auto& bin  = bins_[itr->second.bin];
+        int   slot = itr->second.slot;
+        if (slot != (int)bin.size() - 1)
+        {
+            bin[slot]                = bin.back();
+            entries_[bin[slot]].slot = slot;
+        }
+        bin.pop_back();
+        entries_.erase(itr);
+    }
+    void
+    query(int x_min, int y_min, int x_max, int y_max,
+          std::vector<T>& result) const
+    {
+        if (bins_.empty())
+        {
+            return;
+        }
+        for (int r = row(y_min - reach_); r <= row(y_max + reach_); r++)
+        {
+            for (int col = column(x_min - reach_);
+                 col <= column(x_max + reach_); col++)
+            {
+                for (auto& item : bins_[r * columns_ + col])
+                {
+                    auto& entry = entries_.at(item);
+                    if (entry.x_min <= x_max && entry.x_max >= x_min &&
+                        entry.y_min <= y_max && entry.y_max >= y_min)
+                    {
+                        result.push_back(item);
+                    }
+                }
+            }
+        }
+    }
+    // Visits rings of buckets around the query point until no unvisited
+    // bucket can hold a point closer than the count-th candidate.
+    std::vector<T>
+    nearest(int x, int y, int count) const
+    {
+        std::vector<T> result;
+        if (bins_.empty() || count <= 0)
+        {
+            return result;
+        }
+        std::vector<std::pair<long long, T>> candidates;
+        int                                  col = column(x);
+        int                                  r   = row(y);
+
+        int max_ring = std::max(columns_, rows_);
+        for (int ring = 0; ring <= max_ring; ring++)
+        {
+            if (ring == 0)
+            {
+                collect(col, r, x, y, candidates);
+            }
+            else
+            {
+                for (int i = -ring; i <= ring; i++)
+                {
+                    collect(col + i, r - ring, x, y, candidates);
+                    collect(col + i, r + ring, x, y, candidates);
+                }
+                for (int i = -ring + 1; i <= ring - 1; i++)
+                {
+                    collect(col - ring, r + i, x, y, candidates);
+                    collect(col + ring, r + i, x, y, candidates);
+                }
+            }
+            if ((int)candidates.size() >= count)
+            {
+                std::nth_element(candidates.begin(),
+                                 candidates.begin() + count - 1,
+                                 candidates.end());
+                if (candidates[count - 1].first <= (long long)ring * bin_size_)
+                {
+                    break;
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        int result_count = std::min(count, (int)candidates.size());
+        result.reserve(result_count);
+        for (int i = 0; i < result_count; i++)
+        {
+            result.push_back(candidates[i].second);
+        }
+        return result;
+    }
+};
+} // namespace psn
@@ -0,0 +1,68 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <chrono>
+
+namespace psn
+{
+// Wall-clock and edit limits for a transform run. A limit of zero or less
+// is disabled. Transforms poll exhausted() between edits so that they stop
+// on a consistent netlist.
+class OptimizationBudget
+{
+public:
+    OptimizationBudget();
+    void  setTimeBudget(float seconds);
+    void  setMaxEdits(int max_edits);
+    float timeBudget() const;
+    int   maxEdits() const;
+    bool  hasLimit() const;
+
+    // Start the clock; edit counts passed to exhausted() are relative to
+    // start_edit_count
+    void  start(int start_edit_count = 0);
+    bool  exhausted(int edit_count);
+    // Whether making edits more edits after edit_count stays within the edit
+    // limit
+    bool  fits(int edit_count, int edits) const;
+    bool  isExhausted() const;
+    float elapsed() const;
+
+private:
+    float                                 time_budget_;
+    int                                   max_edits_;
+    int                                   start_edit_count_;
+    bool                                  exhausted_;
+    std::chrono::steady_clock::time_point start_time_;
+};
+} // namespace psn
@@ -0,0 +1,76 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "OpenPhySyn/Database/Types.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace psn
+{
+// Writes OpenDB snapshots without blocking the caller. The database is
+// serialized in memory on the calling thread, so later edits do not affect
+// the snapshot, and written to disk on a background thread. Files are
+// written under a temporary name and renamed into place once every write
+// succeeded, leaving the previous snapshot intact on failure.
+class SnapshotWriter
+{
+public:
+    typedef std::vector<std::pair<std::string, std::string>> ExtraFiles;
+
+    SnapshotWriter();
+    ~SnapshotWriter();
+
+    // Waits for the previous write, then starts writing db to path. extra
+    // files are (path, contents) pairs written along with the snapshot.
+    bool write(Database* db, const std::string& path, bool compress = false,
+               const ExtraFiles& extra_files = ExtraFiles());
+    // Returns false if the last write failed
+    bool wait();
+    bool isRunning() const;
+    bool hasFailed() const;
+    const std::string& path() const;
+
+private:
+    static bool writeFile(const std::string& path, const char* data,
+                          size_t size, bool compress);
+
+    std::thread       thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> failed_;
+    std::string       path_;
+};
+} // namespace psn
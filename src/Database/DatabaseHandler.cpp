@@ -32,8 +32,10 @@
 #include <algorithm>
 #include <cmath>
 #include <set>
+#include <tuple>
 #include "OpenPhySyn/Database/Types.hpp"
 #include "OpenPhySyn/Liberty/LibraryMapping.hpp"
+#include "OpenPhySyn/Optimize/RowLegalizer.hpp"
 #include "OpenPhySyn/Optimize/SteinerTree.hpp"
 #include "OpenPhySyn/PsnLogger/PsnLogger.hpp"
 #include "OpenPhySyn/Sta/DatabaseSta.hpp"
@@ -76,15 +78,20 @@ DatabaseHandler::DatabaseHandler(Psn* psn_inst, DatabaseSta* sta)
       psn_(psn_inst),
       has_wire_rc_(false),
       maximum_area_valid_(false),
-      has_library_cell_mappings_(false)
+      has_library_cell_mappings_(false),
+      design_area_(0.0),
+      design_area_valid_(false),
+      level_drivers_valid_(false),
+      has_violation_index_(false),
+      violation_index_stale_(false),
+      violation_limit_scale_factor_(1.0),
+      spatial_index_valid_(false),
+      design_power_(0.0),
+      has_power_cache_(false)
 {
-    // Use default corner for now
-    corner_                      = sta_->findCorner("default");
     min_max_                     = sta::MinMax::max();
-    dcalc_ap_                    = corner_->findDcalcAnalysisPt(min_max_);
-    pvt_                         = dcalc_ap_->operatingConditions();
-    parasitics_ap_               = corner_->findParasiticAnalysisPt(min_max_);
     legalizer_                   = nullptr;
+    row_legalizer_.reset(new RowLegalizer(this));
     res_per_micron_callback_     = nullptr;
     cap_per_micron_callback_     = nullptr;
     dont_use_callback_           = nullptr;
@@ -97,25 +104,106 @@ std::vector<InstanceTerm*>
 DatabaseHandler::pins(Net* net) const
 {
     std::vector<InstanceTerm*> terms;
-    auto                       pin_iter = network()->pinIterator(net);
-    while (pin_iter->hasNext())
-    {
-        InstanceTerm* pin = pin_iter->next();
-        terms.push_back(pin);
-    }
+    forEachPin(net, [&](InstanceTerm* pin) { terms.push_back(pin); });
     return terms;
 }
 std::vector<InstanceTerm*>
 DatabaseHandler::pins(Instance* inst) const
 {
     std::vector<InstanceTerm*> terms;
-    auto                       pin_iter = network()->pinIterator(inst);
+    forEachPin(inst, [&](InstanceTerm* pin) { terms.push_back(pin); });
+    return terms;
+}
+void
+DatabaseHandler::forEachPin(Net* net, PinVisitor visitor) const
+{
+    auto pin_iter = network()->pinIterator(net);
+    while (pin_iter->hasNext())
+    {
+        visitor(pin_iter->next());
+    }
+    delete pin_iter;
+}
+void
+DatabaseHandler::forEachPin(Instance* inst, PinVisitor visitor) const
+{
+    auto pin_iter = network()->pinIterator(inst);
+    while (pin_iter->hasNext())
+    {
+        visitor(pin_iter->next());
+    }
+    delete pin_iter;
+}
+void
+DatabaseHandler::forEachInputPin(Instance* inst, PinVisitor visitor) const
+{
+    auto handler_network = network();
+    auto pin_iter        = handler_network->pinIterator(inst);
     while (pin_iter->hasNext())
     {
         InstanceTerm* pin = pin_iter->next();
-        terms.push_back(pin);
+        if (handler_network->direction(pin) == PinDirection::input())
+        {
+            visitor(pin);
+        }
     }
-    return terms;
+    delete pin_iter;
+}
+void
+DatabaseHandler::forEachOutputPin(Instance* inst, PinVisitor visitor) const
+{
+    auto handler_network = network();
+    auto pin_iter        = handler_network->pinIterator(inst);
+    while (pin_iter->hasNext())
+    {
+        InstanceTerm* pin = pin_iter->next();
+        if (handler_network->direction(pin) == PinDirection::output())
+        {
+            visitor(pin);
+        }
+    }
+    delete pin_iter;
+}
+void
+DatabaseHandler::forEachFanoutPin(Net* net, PinVisitor visitor,
+                                  bool include_top_level) const
+{
+    auto handler_network = network();
+    auto pin_iter        = handler_network->pinIterator(net);
+    while (pin_iter->hasNext())
+    {
+        InstanceTerm* pin = pin_iter->next();
+        if (handler_network->instance(pin) &&
+            handler_network->direction(pin) == PinDirection::input())
+        {
+            visitor(pin);
+        }
+    }
+    delete pin_iter;
+    if (include_top_level)
+    {
+        auto itr = handler_network->connectedPinIterator(net);
+        while (itr->hasNext())
+        {
+            InstanceTerm* term = itr->next();
+            if (handler_network->isTopLevelPort(term) &&
+                handler_network->direction(term)->isOutput())
+            {
+                visitor(term);
+            }
+        }
+        delete itr;
+    }
+}
+void
+DatabaseHandler::forEachConnectedPin(Net* net, PinVisitor visitor) const
+{
+    auto pin_iter = network()->connectedPinIterator(net);
+    while (pin_iter->hasNext())
+    {
+        visitor(pin_iter->next());
+    }
+    delete pin_iter;
 }
 Net*
 DatabaseHandler::net(InstanceTerm* term) const
@@ -135,13 +223,10 @@ DatabaseHandler::net(Term* term) const
 std::vector<InstanceTerm*>
 DatabaseHandler::connectedPins(Net* net) const
 {
+    // Sorted by name so that Steiner trees built from it are deterministic,
+    // use forEachConnectedPin() where the order does not matter.
     std::vector<InstanceTerm*> terms;
-    auto                       pin_iter = network()->connectedPinIterator(net);
-    while (pin_iter->hasNext())
-    {
-        InstanceTerm* pin = pin_iter->next();
-        terms.push_back(pin);
-    }
+    forEachConnectedPin(net, [&](InstanceTerm* pin) { terms.push_back(pin); });
     std::sort(terms.begin(), terms.end(), sta::PinPathNameLess(network()));
     return terms;
 }
@@ -191,46 +276,29 @@ DatabaseHandler::clockPins() const
 }
 
 std::vector<InstanceTerm*>
-DatabaseHandler::inputPins(Instance* inst, bool include_top_level) const
+DatabaseHandler::inputPins(Instance* inst, bool) const
 {
-    auto inst_pins = pins(inst);
-    return filterPins(inst_pins, PinDirection::input(), include_top_level);
+    std::vector<InstanceTerm*> terms;
+    forEachInputPin(inst, [&](InstanceTerm* pin) { terms.push_back(pin); });
+    return terms;
 }
 
 std::vector<InstanceTerm*>
-DatabaseHandler::outputPins(Instance* inst, bool include_top_level) const
+DatabaseHandler::outputPins(Instance* inst, bool) const
 {
-    auto inst_pins = pins(inst);
-    return filterPins(inst_pins, PinDirection::output(), include_top_level);
+    std::vector<InstanceTerm*> terms;
+    forEachOutputPin(inst, [&](InstanceTerm* pin) { terms.push_back(pin); });
+    return terms;
 }
 
 std::vector<InstanceTerm*>
 DatabaseHandler::fanoutPins(Net* pin_net, bool include_top_level) const
 {
-    auto inst_pins = pins(pin_net);
-
-    auto filtered_inst_pins =
-        filterPins(inst_pins, PinDirection::input(), include_top_level);
-
-    if (include_top_level)
-    {
-        std::vector<InstanceTerm*> filtered_top_pins;
-        auto itr = network()->connectedPinIterator(pin_net);
-        while (itr->hasNext())
-        {
-            InstanceTerm* term = itr->next();
-            if (network()->isTopLevelPort(term) &&
-                network()->direction(term)->isOutput())
-            {
-                filtered_top_pins.push_back(term);
-            }
-        }
-        delete itr;
-        filtered_inst_pins.insert(filtered_inst_pins.end(),
-                                  filtered_top_pins.begin(),
-                                  filtered_top_pins.end());
-    }
-    return filtered_inst_pins;
+    std::vector<InstanceTerm*> terms;
+    forEachFanoutPin(
+        pin_net, [&](InstanceTerm* pin) { terms.push_back(pin); },
+        include_top_level);
+    return terms;
 }
 
 bool
@@ -1344,20 +1412,21 @@ DatabaseHandler::slew(InstanceTerm* term, bool is_rise) const
                                 sta::MinMax::max());
     }
 
-    auto pin_net = net(term);
-
-    auto net_pins = pins(pin_net);
-
-    for (auto connected_pin : net_pins)
+    auto pin_net  = net(term);
+    auto pin_iter = network()->pinIterator(pin_net);
+    while (pin_iter->hasNext())
     {
+        InstanceTerm* connected_pin = pin_iter->next();
         if (connected_pin != term)
         {
+            delete pin_iter;
             return sta_->vertexSlew(vertex(connected_pin),
                                     is_rise ? sta::RiseFall::rise()
                                             : sta::RiseFall::fall(),
                                     sta::MinMax::max());
         }
     }
+    delete pin_iter;
     return sta_->vertexSlew(
         vertex(term), is_rise ? sta::RiseFall::rise() : sta::RiseFall::fall(),
         sta::MinMax::max());
@@ -1394,6 +1463,34 @@ DatabaseHandler::required(InstanceTerm* term, bool is_rise,
     }
     return req;
 }
+float
+DatabaseHandler::cornerRequired(InstanceTerm* term, int corner_index) const
+{
+    auto vert    = network()->graph()->pinLoadVertex(term);
+    auto path_ap = findCorner(corner_index)->findPathAnalysisPt(min_max_);
+    auto req     = std::min(
+        sta_->vertexRequired(vert, sta::RiseFall::rise(), path_ap),
+        sta_->vertexRequired(vert, sta::RiseFall::fall(), path_ap));
+    if (sta::fuzzyInf(req))
+    {
+        return 0;
+    }
+    return req;
+}
+float
+DatabaseHandler::cornerArrival(InstanceTerm* term, int corner_index) const
+{
+    auto vert    = network()->graph()->pinDrvrVertex(term);
+    auto path_ap = findCorner(corner_index)->findPathAnalysisPt(min_max_);
+    auto arr     = std::max(
+        sta_->vertexArrival(vert, sta::RiseFall::rise(), path_ap),
+        sta_->vertexArrival(vert, sta::RiseFall::fall(), path_ap));
+    if (sta::fuzzyInf(arr))
+    {
+        return 0;
+    }
+    return arr;
+}
 std::vector<std::vector<PathPoint>>
 DatabaseHandler::getPaths(bool get_max, int path_count) const
 {
@@ -1404,7 +1501,8 @@ DatabaseHandler::getPaths(bool get_max, int path_count) const
         sta_->search()->findPathEnds( // from, thrus, to, unconstrained
             nullptr, nullptr, nullptr, false,
             // corner, min_max,
-            corner_, get_max ? sta::MinMaxAll::max() : sta::MinMaxAll::min(),
+            cmdCorner(),
+            get_max ? sta::MinMaxAll::max() : sta::MinMaxAll::min(),
             // group_count, endpoint_count, unique_pins
             path_count, path_count, true, -sta::INF,
             sta::INF, // slack_min, slack_max,
@@ -1606,34 +1704,146 @@ DatabaseHandler::levelDriverPins(bool reverse) const
     sta_->ensureGraph();
     sta_->ensureLevelized();
 
-    auto handler_network = network();
+    if (!level_drivers_valid_)
+    {
+        sortLevelDrivers();
+    }
+    else if (level_drivers_added_.size() || level_drivers_removed_.size() ||
+             level_drivers_dirty_.size())
+    {
+        updateLevelDrivers();
+    }
 
     std::vector<InstanceTerm*> terms;
-    std::vector<Vertex*>       vertices;
-    sta::VertexIterator        itr(handler_network->graph());
+    terms.reserve(level_drivers_.size());
+    if (reverse)
+    {
+        for (auto itr = level_drivers_.rbegin(); itr != level_drivers_.rend();
+             itr++)
+        {
+            terms.push_back(itr->pin);
+        }
+    }
+    else
+    {
+        for (auto& driver : level_drivers_)
+        {
+            terms.push_back(driver.pin);
+        }
+    }
+    return terms;
+}
+
+bool
+DatabaseHandler::levelDriverLess(const LevelDriver& d1, const LevelDriver& d2)
+{
+    return d1.level < d2.level || (d1.level == d2.level && d1.id < d2.id);
+}
+
+void
+DatabaseHandler::sortLevelDrivers() const
+{
+    auto handler_network = network();
+    auto graph           = handler_network->graph();
+
+    level_drivers_.clear();
+    sta::VertexIterator itr(graph);
     while (itr.hasNext())
     {
         Vertex* vtx = itr.next();
         if (vtx->isDriver(handler_network))
-            vertices.push_back(vtx);
-    }
-    std::sort(
-        vertices.begin(), vertices.end(),
-        [=](const Vertex* v1, const Vertex* v2) -> bool {
-            return (v1->level() < v2->level()) ||
-                   (v1->level() == v2->level() &&
-                    sta::stringLess(handler_network->pathName(v1->pin()),
-                                    handler_network->pathName(v2->pin())));
-        });
-    for (auto& v : vertices)
+        {
+            level_drivers_.push_back({vtx->level(), graph->id(vtx), vtx->pin()});
+        }
+    }
+    std::sort(level_drivers_.begin(), level_drivers_.end(), levelDriverLess);
+    level_drivers_added_.clear();
+    level_drivers_removed_.clear();
+    level_drivers_dirty_.clear();
+    level_drivers_valid_ = true;
+}
+
+void
+DatabaseHandler::updateLevelDrivers() const
+{
+    // A rewired or new driver can change the level of everything in its
+    // fanout cone. Sequential cells are only entered through clock pins since
+    // their data inputs do not feed the level of their outputs.
+    auto handler_network = network();
+    auto graph           = handler_network->graph();
+    std::vector<InstanceTerm*> worklist(level_drivers_added_.begin(),
+                                        level_drivers_added_.end());
+    std::unordered_set<InstanceTerm*> cone(worklist.begin(), worklist.end());
+    for (auto& pin : level_drivers_dirty_)
     {
-        terms.push_back(v->pin());
+        if (!level_drivers_removed_.count(pin) && cone.insert(pin).second)
+        {
+            worklist.push_back(pin);
+        }
     }
-    if (reverse)
+    while (!worklist.empty())
+    {
+        auto driver = worklist.back();
+        worklist.pop_back();
+        auto driver_net = net(driver);
+        if (!driver_net)
+        {
+            continue;
+        }
+        forEachFanoutPin(driver_net, [&](InstanceTerm* fanout_pin) {
+            auto inst    = handler_network->instance(fanout_pin);
+            auto lib_pin = libraryPin(fanout_pin);
+            if (!isCombinational(inst) && !(lib_pin && lib_pin->isClock()))
+            {
+                return;
+            }
+            forEachOutputPin(inst, [&](InstanceTerm* out_pin) {
+                if (cone.insert(out_pin).second)
+                {
+                    worklist.push_back(out_pin);
+                }
+            });
+        });
+    }
+
+    level_drivers_.erase(
+        std::remove_if(level_drivers_.begin(), level_drivers_.end(),
+                       [&](const LevelDriver& driver) -> bool {
+                           return level_drivers_removed_.count(driver.pin) ||
+                                  cone.count(driver.pin);
+                       }),
+        level_drivers_.end());
+    // Drivers outside the cone keep their levels and the order of the last
+    // sort; the cone is re-read and merged back in.
+    size_t sorted_count = level_drivers_.size();
+    for (auto& pin : cone)
+    {
+        Vertex* vtx = vertex(pin);
+        if (vtx && vtx->isDriver(handler_network))
+        {
+            level_drivers_.push_back({vtx->level(), graph->id(vtx), pin});
+        }
+    }
+    std::sort(level_drivers_.begin() + sorted_count, level_drivers_.end(),
+              levelDriverLess);
+    std::inplace_merge(level_drivers_.begin(),
+                       level_drivers_.begin() + sorted_count,
+                       level_drivers_.end(), levelDriverLess);
+    level_drivers_added_.clear();
+    level_drivers_removed_.clear();
+    level_drivers_dirty_.clear();
+}
+
+void
+DatabaseHandler::invalidateLevels(Instance* inst) const
+{
+    if (!level_drivers_valid_ || !inst || inst == network()->topInstance())
     {
-        std::reverse(terms.begin(), terms.end());
+        return;
     }
-    return terms;
+    forEachOutputPin(inst, [&](InstanceTerm* pin) {
+        level_drivers_dirty_.insert(pin);
+    });
 }
 
 InstanceTerm*
@@ -1644,31 +1854,28 @@ DatabaseHandler::faninPin(InstanceTerm* term) const
 InstanceTerm*
 DatabaseHandler::faninPin(Net* net) const
 {
-    auto net_pins = pins(net);
-    for (auto& pin : net_pins)
+    auto pin_iter = network()->pinIterator(net);
+    while (pin_iter->hasNext())
     {
-        Instance* inst = network()->instance(pin);
-        if (inst)
+        InstanceTerm* pin  = pin_iter->next();
+        Instance*     inst = network()->instance(pin);
+        if (inst && network()->direction(pin)->isOutput())
         {
-            if (network()->direction(pin)->isOutput())
-            {
-                return pin;
-            }
+            delete pin_iter;
+            return pin;
         }
     }
-
+    delete pin_iter;
     return nullptr;
 }
 
 std::vector<Instance*>
 DatabaseHandler::fanoutInstances(Net* net) const
 {
-    std::vector<Instance*>     insts;
-    std::vector<InstanceTerm*> net_pins = fanoutPins(net, false);
-    for (auto& term : net_pins)
-    {
+    std::vector<Instance*> insts;
+    forEachFanoutPin(net, [&](InstanceTerm* term) {
         insts.push_back(network()->instance(term));
-    }
+    });
     return insts;
 }
 
@@ -1694,35 +1901,45 @@ DatabaseHandler::driverInstances() const
 unsigned int
 DatabaseHandler::fanoutCount(Net* net, bool include_top_level) const
 {
-    return fanoutPins(net, include_top_level).size();
+    unsigned int count = 0;
+    forEachFanoutPin(
+        net, [&](InstanceTerm*) { count++; }, include_top_level);
+    return count;
 }
 
 Point
 DatabaseHandler::location(InstanceTerm* term)
 {
+    {
+        std::lock_guard<std::mutex> lock(pin_locations_mutex_);
+        auto                        itr = pin_locations_.find(term);
+        if (itr != pin_locations_.end())
+        {
+            return Point(itr->second.first, itr->second.second);
+        }
+    }
     odb::dbITerm* iterm;
     odb::dbBTerm* bterm;
     network()->staToDb(term, iterm, bterm);
+    int x = 0, y = 0;
     if (iterm)
     {
-        int x, y;
-        if (iterm->getAvgXY(&x, &y))
-        {
-            return Point(x, y);
-        }
-        else
+        if (!iterm->getAvgXY(&x, &y))
         {
             iterm->getInst()->getOrigin(x, y);
-            return Point(x, y);
         }
     }
-    if (bterm)
+    else if (bterm)
     {
-        int x, y;
-        if (bterm->getFirstPinLocation(x, y))
-            return Point(x, y);
+        if (!bterm->getFirstPinLocation(x, y))
+        {
+            x = 0;
+            y = 0;
+        }
     }
-    return Point(0, 0);
+    std::lock_guard<std::mutex> lock(pin_locations_mutex_);
+    pin_locations_[term] = std::make_pair(x, y);
+    return Point(x, y);
 }
 
 Point
@@ -1738,7 +1955,143 @@ DatabaseHandler::setLocation(Instance* inst, Point pt)
 {
     odb::dbInst* dinst = network()->staToDb(inst);
     dinst->setPlacementStatus(odb::dbPlacementStatus::PLACED);
+    moveInstance(inst, pt);
+    if (!legalizer_)
+    {
+        row_legalizer_->add(inst);
+    }
+}
+void
+DatabaseHandler::setPlacement(Instance* inst, Point pt, const char* orient,
+                              const char* status)
+{
+    odb::dbInst*           dinst = network()->staToDb(inst);
+    odb::dbPlacementStatus placement_status(status);
+    // Orientation first, so the cached pin locations and the spatial index
+    // are computed for the final placement.
+    dinst->setOrient(odb::dbOrientType(orient));
+    dinst->setPlacementStatus(placement_status);
+    moveInstance(inst, pt);
+    if (!legalizer_ && placement_status == odb::dbPlacementStatus::PLACED)
+    {
+        row_legalizer_->add(inst);
+    }
+}
+void
+DatabaseHandler::moveInstance(Instance* inst, Point pt)
+{
+    odb::dbInst* dinst = network()->staToDb(inst);
     dinst->setLocation(pt.getX(), pt.getY());
+    updateLocations(inst);
+    trackInstanceChange(inst);
+    invalidateInstance(inst);
+}
+void
+DatabaseHandler::updateLocations(Instance* inst)
+{
+    {
+        std::lock_guard<std::mutex> lock(pin_locations_mutex_);
+        forEachPin(inst, [&](InstanceTerm* pin) { pin_locations_.erase(pin); });
+    }
+    if (spatial_index_valid_)
+    {
+        indexInstance(inst);
+        forEachPin(inst, [&](InstanceTerm* pin) {
+            Point pin_loc = location(pin);
+            pin_index_.insert(pin, pin_loc.getX(), pin_loc.getY());
+        });
+    }
+}
+void
+DatabaseHandler::indexInstance(Instance* inst)
+{
+    Point       loc = location(inst);
+    odb::dbBox* box = network()->staToDb(inst)->getBBox();
+    instance_index_.insert(inst, loc.getX(), loc.getY(), box->xMin(),
+                           box->yMin(), box->xMax(), box->yMax());
+}
+void
+DatabaseHandler::buildSpatialIndex()
+{
+    clearSpatialIndex();
+    auto block = top();
+    if (!block)
+    {
+        return;
+    }
+    Rect die;
+    block->getDieArea(die);
+    auto insts    = instances();
+    int  count    = std::max((int)insts.size(), 1);
+    int  bin_size = std::sqrt(4.0 * die.dx() * die.dy() / count);
+    instance_index_.reset(die.xMin(), die.yMin(), die.xMax(), die.yMax(),
+                          bin_size);
+    pin_index_.reset(die.xMin(), die.yMin(), die.xMax(), die.yMax(),
+                     bin_size / 2);
+    for (auto& inst : insts)
+    {
+        if (!network()->staToDb(inst)->getPlacementStatus().isPlaced())
+        {
+            continue;
+        }
+        indexInstance(inst);
+        forEachPin(inst, [&](InstanceTerm* pin) {
+            Point pin_loc = location(pin);
+            pin_index_.insert(pin, pin_loc.getX(), pin_loc.getY());
+        });
+    }
+    forEachPin(network()->topInstance(), [&](InstanceTerm* pin) {
+        Point pin_loc = location(pin);
+        pin_index_.insert(pin, pin_loc.getX(), pin_loc.getY());
+    });
+    spatial_index_valid_ = true;
+}
+void
+DatabaseHandler::clearSpatialIndex()
+{
+    instance_index_.clear();
+    pin_index_.clear();
+    spatial_index_valid_ = false;
+}
+std::vector<Instance*>
+DatabaseHandler::instancesInRegion(int x_min, int y_min, int x_max, int y_max)
+{
+    if (!spatial_index_valid_)
+    {
+        buildSpatialIndex();
+    }
+    std::vector<Instance*> result;
+    instance_index_.query(x_min, y_min, x_max, y_max, result);
+    return result;
+}
+std::vector<Instance*>
+DatabaseHandler::nearestInstances(Point pt, int count)
+{
+    if (!spatial_index_valid_)
+    {
+        buildSpatialIndex();
+    }
+    return instance_index_.nearest(pt.getX(), pt.getY(), count);
+}
+std::vector<InstanceTerm*>
+DatabaseHandler::pinsInRegion(int x_min, int y_min, int x_max, int y_max)
+{
+    if (!spatial_index_valid_)
+    {
+        buildSpatialIndex();
+    }
+    std::vector<InstanceTerm*> result;
+    pin_index_.query(x_min, y_min, x_max, y_max, result);
+    return result;
+}
+std::vector<InstanceTerm*>
+DatabaseHandler::nearestPins(Point pt, int count)
+{
+    if (!spatial_index_valid_)
+    {
+        buildSpatialIndex();
+    }
+    return pin_index_.nearest(pt.getX(), pt.getY(), count);
 }
 float
 DatabaseHandler::area(Instance* inst) const
@@ -1757,21 +2110,33 @@ DatabaseHandler::area(LibraryCell* cell) const
 float
 DatabaseHandler::area() const
 {
-    float total_area = 0.0;
-    for (auto inst : instances())
+    if (!design_area_valid_)
     {
-        total_area += area(inst);
+        design_area_ = 0.0;
+        for (auto inst : instances())
+        {
+            design_area_ += area(inst);
+        }
+        design_area_valid_ = true;
     }
-    return total_area;
+    return design_area_;
 }
 float
 DatabaseHandler::power(std::vector<Instance*>& insts)
 {
-    float            total_pwr = 0.0;
+    float total_pwr = 0.0;
+    if (has_power_cache_)
+    {
+        for (auto inst : insts)
+        {
+            total_pwr += instancePower(inst);
+        }
+        return total_pwr;
+    }
     sta::PowerResult total;
     for (auto inst : insts)
     {
-        sta_->power(inst, corner_, total);
+        sta_->power(inst, cmdCorner(), total);
         total_pwr += total.total();
     }
     return total_pwr;
@@ -1781,21 +2146,122 @@ float
 DatabaseHandler::power()
 {
     sta::PowerResult total, sequential, combinational, macro, pad;
-    sta_->power(corner_, total, sequential, combinational, macro, pad);
+    sta_->power(cmdCorner(), total, sequential, combinational, macro, pad);
     return total.total();
 }
-LibraryTerm*
-DatabaseHandler::libraryPin(InstanceTerm* term) const
+
+float
+DatabaseHandler::instancePower(Instance* inst)
 {
-    return network()->libertyPort(term);
+    if (!has_power_cache_)
+    {
+        sta::PowerResult result;
+        sta_->power(inst, cmdCorner(), result);
+        return result.total();
+    }
+    updatePowerCache();
+    auto itr = instance_power_.find(inst);
+    if (itr != instance_power_.end())
+    {
+        return itr->second;
+    }
+    sta::PowerResult result;
+    sta_->power(inst, cmdCorner(), result);
+    instance_power_[inst] = result.total();
+    design_power_ += result.total();
+    return result.total();
 }
 
-Port*
-DatabaseHandler::topPort(InstanceTerm* term) const
+float
+DatabaseHandler::cachedPower()
 {
-    return network()->port(term);
+    if (!has_power_cache_)
+    {
+        buildPowerCache();
+    }
+    updatePowerCache();
+    return design_power_;
 }
-bool
+
+void
+DatabaseHandler::buildPowerCache()
+{
+    clearPowerCache();
+    for (auto& inst : instances())
+    {
+        sta::PowerResult result;
+        sta_->power(inst, cmdCorner(), result);
+        instance_power_[inst] = result.total();
+        design_power_ += result.total();
+    }
+    has_power_cache_ = true;
+}
+
+void
+DatabaseHandler::clearPowerCache()
+{
+    instance_power_.clear();
+    power_dirty_nets_.clear();
+    power_dirty_insts_.clear();
+    design_power_    = 0.0;
+    has_power_cache_ = false;
+}
+
+bool
+DatabaseHandler::hasPowerCache() const
+{
+    return has_power_cache_;
+}
+
+void
+DatabaseHandler::updatePowerCache()
+{
+    if (power_dirty_nets_.empty() && power_dirty_insts_.empty())
+    {
+        return;
+    }
+    // A changed net alters the load of its driver and the input slew of its
+    // sinks, so the instances on both sides are re-evaluated.
+    auto top_inst = network()->topInstance();
+    for (auto& dirty_net : power_dirty_nets_)
+    {
+        forEachPin(dirty_net, [&](InstanceTerm* pin) {
+            auto inst = network()->instance(pin);
+            if (inst != top_inst)
+            {
+                power_dirty_insts_.insert(inst);
+            }
+        });
+    }
+    for (auto& inst : power_dirty_insts_)
+    {
+        sta::PowerResult result;
+        sta_->power(inst, cmdCorner(), result);
+        auto& inst_power = instance_power_[inst];
+        design_power_ += result.total() - inst_power;
+        inst_power = result.total();
+    }
+    power_dirty_nets_.clear();
+    power_dirty_insts_.clear();
+}
+
+float
+DatabaseHandler::activity(InstanceTerm* term)
+{
+    return sta_->power()->findClkedActivity(term).activity();
+}
+LibraryTerm*
+DatabaseHandler::libraryPin(InstanceTerm* term) const
+{
+    return network()->libertyPort(term);
+}
+
+Port*
+DatabaseHandler::topPort(InstanceTerm* term) const
+{
+    return network()->port(term);
+}
+bool
 DatabaseHandler::isClocked(InstanceTerm* term) const
 {
     return sta_->search()->isClock(vertex(term));
@@ -1803,14 +2269,11 @@ DatabaseHandler::isClocked(InstanceTerm* term) const
 bool
 DatabaseHandler::isPrimary(Net* net) const
 {
-    for (auto& pin : pins(net))
-    {
-        if (network()->isTopLevelPort(pin))
-        {
-            return true;
-        }
-    }
-    return false;
+    bool is_primary = false;
+    forEachPin(net, [&](InstanceTerm* pin) {
+        is_primary = is_primary || network()->isTopLevelPort(pin);
+    });
+    return is_primary;
 }
 
 LibraryCell*
@@ -2036,8 +2499,8 @@ DatabaseHandler::pinTableLookup(LibraryTerm* from, LibraryTerm* to, float slew,
                 if (model)
                 {
                     return delay_slew_model->findValue(
-                        lib_cell->libertyLibrary(), lib_cell, pvt_, slew, cap,
-                        0);
+                        lib_cell->libertyLibrary(), lib_cell, cmdPvt(), slew,
+                        cap, 0);
                 }
             }
         }
@@ -2073,9 +2536,9 @@ DatabaseHandler::slew(LibraryTerm* term, float load_cap, float* tr_slew)
                     tr_slew ? *tr_slew : target_slews_[in_rf->index()];
                 sta::ArcDelay gate_delay;
                 sta::Slew     drvr_slew;
-                sta_->arcDelayCalc()->gateDelay(cell, arc, in_slew, load_cap,
-                                                nullptr, 0.0, pvt_, dcalc_ap_,
-                                                gate_delay, drvr_slew);
+                sta_->arcDelayCalc()->gateDelay(
+                    cell, arc, in_slew, load_cap, nullptr, 0.0, cmdPvt(),
+                    cmdDcalcAnalysisPt(), gate_delay, drvr_slew);
                 max_slew = std::max(max_slew, drvr_slew);
             }
         }
@@ -2129,7 +2592,7 @@ DatabaseHandler::pinTableAverage(LibraryTerm* from, LibraryTerm* to,
                         for (size_t j = 0; j < axis2->size(); j++)
                         {
                             sum += delay_slew_model->findValue(
-                                lib_cell->libertyLibrary(), lib_cell, pvt_,
+                                lib_cell->libertyLibrary(), lib_cell, cmdPvt(),
                                 axis1->axisValue(i), axis2->axisValue(j), 0);
                             count++;
                         }
@@ -2148,7 +2611,12 @@ DatabaseHandler::pinTableAverage(LibraryTerm* from, LibraryTerm* to,
 float
 DatabaseHandler::loadCapacitance(InstanceTerm* term) const
 {
-    return network()->graphDelayCalc()->loadCap(term, dcalc_ap_);
+    return network()->graphDelayCalc()->loadCap(term, cmdDcalcAnalysisPt());
+}
+InstanceTerm*
+DatabaseHandler::pin(const char* name) const
+{
+    return network()->findPin(name);
 }
 Instance*
 DatabaseHandler::instance(const char* name) const
@@ -2262,15 +2730,58 @@ void
 DatabaseHandler::setLegalizer(Legalizer& legalizer)
 {
     legalizer_ = legalizer;
+    // The queue and occupancy are only kept up to date while the row
+    // legalizer is the active one.
+    row_legalizer_->reset();
 }
 bool
 DatabaseHandler::legalize(int max_displacement)
 {
-    if (legalizer_)
+    // The row legalizer moves cells through moveInstance(), which keeps the
+    // caches current on its own.
+    if (!legalizer_)
     {
-        return legalizer_(max_displacement);
+        return row_legalizer_->legalize(max_displacement);
     }
-    return false;
+    bool   legal;
+    Block* block = top();
+    if (block)
+    {
+        // The external legalizer moves cells behind the handler's back, so
+        // its moves are recorded for the ECO by comparing the placement.
+        std::unordered_map<odb::dbInst*, std::tuple<int, int, int>> placement;
+        for (odb::dbInst* dinst : block->getInsts())
+        {
+            int x, y;
+            dinst->getLocation(x, y);
+            placement[dinst] = std::make_tuple(x, y, (int)dinst->getOrient());
+        }
+        legal = legalizer_(max_displacement);
+        for (odb::dbInst* dinst : block->getInsts())
+        {
+            int x, y;
+            dinst->getLocation(x, y);
+            auto itr = placement.find(dinst);
+            if (itr != placement.end() &&
+                itr->second !=
+                    std::make_tuple(x, y, (int)dinst->getOrient()))
+            {
+                trackInstanceChange(network()->dbToSta(dinst));
+            }
+        }
+    }
+    else
+    {
+        legal = legalizer_(max_displacement);
+    }
+    // It can also move any cell, so the violation index is rebuilt on its
+    // next query, and the spatial index and cached pin locations on their
+    // next use.
+    violation_index_stale_ = has_violation_index_;
+    clearSpatialIndex();
+    std::lock_guard<std::mutex> lock(pin_locations_mutex_);
+    pin_locations_.clear();
+    return legal;
 }
 bool
 DatabaseHandler::isTopLevel(InstanceTerm* term) const
@@ -2278,21 +2789,93 @@ DatabaseHandler::isTopLevel(InstanceTerm* term) const
     return network()->isTopLevelPort(term);
 }
 void
-DatabaseHandler::del(Net* net) const
+DatabaseHandler::del(Net* net)
 {
+    violation_dirty_nets_.erase(net);
+    power_dirty_nets_.erase(net);
+    auto net_name = name(net);
+    eco_changes_.modified_nets.erase(net_name);
+    eco_changes_.removed_nets.insert(net_name);
     sta_->deleteNet(net);
 }
 void
-DatabaseHandler::del(Instance* inst) const
+DatabaseHandler::del(Instance* inst)
 {
+    if (design_area_valid_)
+    {
+        design_area_ -= area(inst);
+    }
+    if (level_drivers_valid_)
+    {
+        forEachOutputPin(inst, [&](InstanceTerm* pin) {
+            level_drivers_added_.erase(pin);
+            level_drivers_dirty_.erase(pin);
+            level_drivers_removed_.insert(pin);
+            auto pin_net = net(pin);
+            if (pin_net)
+            {
+                forEachFanoutPin(pin_net, [&](InstanceTerm* fanout_pin) {
+                    invalidateLevels(network()->instance(fanout_pin));
+                });
+            }
+        });
+    }
+    forEachPin(inst, [&](InstanceTerm* pin) {
+        invalidateNet(net(pin));
+        trackNetChange(net(pin));
+    });
+    auto inst_name = name(inst);
+    if (!eco_changes_.added_instances.erase(inst_name))
+    {
+        eco_changes_.modified_instances.erase(inst_name);
+        eco_changes_.removed_instances.insert(inst_name);
+    }
+    if (has_violation_index_)
+    {
+        for (auto& pin : pins(inst))
+        {
+            violation_dirty_pins_.erase(pin);
+            violation_slews_.erase(pin);
+            auto itr = violation_index_.find(pin);
+            if (itr != violation_index_.end())
+            {
+                violation_order_.erase(
+                    std::make_pair(itr->second.first, pin));
+                violation_index_.erase(itr);
+            }
+        }
+    }
+    if (has_power_cache_)
+    {
+        power_dirty_insts_.erase(inst);
+        auto itr = instance_power_.find(inst);
+        if (itr != instance_power_.end())
+        {
+            design_power_ -= itr->second;
+            instance_power_.erase(itr);
+        }
+    }
+    row_legalizer_->remove(inst);
+    instance_index_.remove(inst);
+    {
+        std::lock_guard<std::mutex> lock(pin_locations_mutex_);
+        forEachPin(inst, [&](InstanceTerm* pin) {
+            pin_locations_.erase(pin);
+            pin_index_.remove(pin);
+        });
+    }
     sta_->deleteInstance(inst);
 }
 int
 DatabaseHandler::disconnectAll(Net* net) const
 {
+    invalidateNet(net);
+    trackNetChange(net);
     int count = 0;
     for (auto& pin : pins(net))
     {
+        invalidatePin(pin);
+        invalidateLevels(network()->instance(pin));
         sta_->disconnectPin(pin);
         count++;
     }
@@ -2306,11 +2889,18 @@ DatabaseHandler::connect(Net* net, InstanceTerm* term) const
     auto inst      = network()->instance(term);
     auto term_port = network()->port(term);
     sta_->connectPin(inst, term_port, net);
+    invalidateNet(net);
+    invalidateLevels(inst);
+    trackNetChange(net);
 }
 
 void
 DatabaseHandler::disconnect(InstanceTerm* term) const
 {
+    invalidateNet(net(term));
+    invalidatePin(term);
+    invalidateLevels(network()->instance(term));
+    trackNetChange(net(term));
     sta_->disconnectPin(term);
 }
 
@@ -2334,7 +2924,34 @@ DatabaseHandler::swapPins(InstanceTerm* first, InstanceTerm* second)
 Instance*
 DatabaseHandler::createInstance(const char* inst_name, LibraryCell* cell)
 {
-    return sta_->makeInstance(inst_name, cell, network()->topInstance());
+    auto inst = sta_->makeInstance(inst_name, cell, network()->topInstance());
+    if (design_area_valid_ && inst)
+    {
+        design_area_ += area(inst);
+    }
+    if (level_drivers_valid_)
+    {
+        forEachOutputPin(inst, [&](InstanceTerm* pin) {
+            level_drivers_added_.insert(pin);
+        });
+    }
+    if (has_power_cache_ && inst)
+    {
+        power_dirty_insts_.insert(inst);
+    }
+    if (inst)
+    {
+        auto new_name = name(inst);
+        if (eco_changes_.removed_instances.erase(new_name))
+        {
+            eco_changes_.modified_instances.insert(new_name);
+        }
+        else
+        {
+            eco_changes_.added_instances.insert(new_name);
+        }
+    }
+    return inst;
 }
 
 void
@@ -2370,6 +2987,7 @@ Net*
 DatabaseHandler::createNet(const char* net_name)
 {
     auto net = sta_->makeNet(net_name, network()->topInstance());
+    trackNetChange(net);
     return net;
 }
 float
@@ -2407,11 +3025,17 @@ DatabaseHandler::capacitancePerMicron() const
 void
 DatabaseHandler::connect(Net* net, Instance* inst, LibraryTerm* port) const
 {
+    invalidateNet(net);
+    invalidateLevels(inst);
+    trackNetChange(net);
     sta_->connectPin(inst, port, net);
 }
 void
 DatabaseHandler::connect(Net* net, Instance* inst, Port* port) const
 {
+    invalidateNet(net);
+    invalidateLevels(inst);
+    trackNetChange(net);
     sta_->connectPin(inst, port, net);
 }
 
@@ -2565,8 +3189,25 @@ DatabaseHandler::~DatabaseHandler()
 {
 }
 void
+DatabaseHandler::resetNetlistCache()
+{
+    design_area_valid_ = false;
+    clearViolationIndex();
+    level_drivers_.clear();
+    level_drivers_added_.clear();
+    level_drivers_removed_.clear();
+    level_drivers_dirty_.clear();
+    level_drivers_valid_ = false;
+    row_legalizer_->reset();
+    clearSpatialIndex();
+    clearPowerCache();
+    std::lock_guard<std::mutex> lock(pin_locations_mutex_);
+    pin_locations_.clear();
+}
+void
 DatabaseHandler::clear()
 {
+    resetNetlistCache();
     sta_->clear();
     db_->clear();
 }
@@ -2699,10 +3340,25 @@ DatabaseHandler::replaceInstance(Instance* inst, LibraryCell* cell)
         auto db_lib_cell  = db_->findMaster(current_name.c_str());
         if (db_lib_cell)
         {
+            invalidateInstance(inst);
             auto db_inst     = network()->staToDb(inst);
             auto db_inst_lib = db_inst->getMaster();
             auto sta_cell    = network()->dbToSta(db_lib_cell);
+            if (design_area_valid_)
+            {
+                design_area_ -= area(inst);
+            }
             sta_->replaceCell(inst, sta_cell);
+            if (design_area_valid_)
+            {
+                design_area_ += area(inst);
+            }
+            if (!legalizer_)
+            {
+                row_legalizer_->add(inst);
+            }
+            updateLocations(inst);
+            trackInstanceChange(inst);
         }
     }
 }
@@ -2909,11 +3565,86 @@ DatabaseHandler::hasElectricalViolation(InstanceTerm* pin,
     }
 }
 
+// Classifies a net for the violation index. severity is the largest
+// relative excess over any limit on the net and max_slew the worst slew seen
+// on it.
+ElectircalViolation
+DatabaseHandler::netViolation(Net* pin_net, float limit_scale_factor,
+                              float* severity, float* max_slew) const
+{
+    if (severity)
+    {
+        *severity = 0.0;
+    }
+    if (max_slew)
+    {
+        *max_slew = 0.0;
+    }
+    if (!pin_net)
+    {
+        return ElectircalViolation::None;
+    }
+    bool vio_trans = false;
+    bool vio_cap   = false;
+    auto pin_iter  = network()->pinIterator(pin_net);
+    while (pin_iter->hasNext())
+    {
+        InstanceTerm*        pin = pin_iter->next();
+        const sta::Corner*   corner;
+        const sta::RiseFall* rf;
+        float                value, limit, diff;
+        sta_->checkSlew(pin, nullptr, sta::MinMax::max(), false, corner, rf,
+                        value, limit, diff);
+        if (max_slew)
+        {
+            *max_slew = std::max(*max_slew, value);
+        }
+        limit *= limit_scale_factor;
+        if (limit > 0.0 && value > limit)
+        {
+            vio_trans = true;
+            if (severity)
+            {
+                *severity = std::max(*severity, (value - limit) / limit);
+            }
+        }
+        sta_->checkCapacitance(pin, nullptr, sta::MinMax::max(), corner, rf,
+                               value, limit, diff);
+        limit *= limit_scale_factor;
+        if (limit > 0.0 && value > limit)
+        {
+            vio_cap = true;
+            if (severity)
+            {
+                *severity = std::max(*severity, (value - limit) / limit);
+            }
+        }
+    }
+    delete pin_iter;
+    if (vio_cap && vio_trans)
+    {
+        return ElectircalViolation::CapacitanceAndTransition;
+    }
+    else if (vio_trans)
+    {
+        return ElectircalViolation::Transition;
+    }
+    else if (vio_cap)
+    {
+        return ElectircalViolation::Capacitance;
+    }
+    else
+    {
+        return ElectircalViolation::None;
+    }
+}
+
 std::vector<InstanceTerm*>
 DatabaseHandler::maximumTransitionViolations(float limit_scale_factor) const
 {
     sta_->findDelays();
-    auto vio_pins = sta_->pinSlewLimitViolations(corner_, sta::MinMax::max());
+    auto vio_pins =
+        sta_->pinSlewLimitViolations(cmdCorner(), sta::MinMax::max());
     return std::vector<InstanceTerm*>(vio_pins->begin(), vio_pins->end());
 }
 std::vector<InstanceTerm*>
@@ -2921,10 +3652,377 @@ DatabaseHandler::maximumCapacitanceViolations(float limit_scale_factor) const
 {
     sta_->findDelays();
     auto vio_pins =
-        sta_->pinCapacitanceLimitViolations(corner_, sta::MinMax::max());
+        sta_->pinCapacitanceLimitViolations(cmdCorner(), sta::MinMax::max());
     return std::vector<InstanceTerm*>(vio_pins->begin(), vio_pins->end());
 }
 
+void
+DatabaseHandler::pinTimings(const std::vector<InstanceTerm*>& terms,
+                            PinTimings& timings, float limit_scale_factor) const
+{
+    // Required times and delays are brought up to date once for the whole
+    // batch instead of once per pin.
+    sta_->ensureLevelized();
+    sta_->findRequireds();
+
+    size_t count = terms.size();
+    timings.slacks.resize(count);
+    timings.slews.resize(count);
+    timings.loads.resize(count);
+    timings.slew_limits.resize(count);
+    timings.capacitance_limits.resize(count);
+    timings.violations.resize(count);
+
+    auto delay_calc = network()->graphDelayCalc();
+    for (size_t i = 0; i < count; i++)
+    {
+        auto term = terms[i];
+        auto vert = term ? vertex(term) : nullptr;
+        if (!vert)
+        {
+            timings.slacks[i]             = sta::INF;
+            timings.slews[i]              = 0.0;
+            timings.loads[i]              = 0.0;
+            timings.slew_limits[i]        = 0.0;
+            timings.capacitance_limits[i] = 0.0;
+            timings.violations[i]         = ElectircalViolation::None;
+            continue;
+        }
+        sta::PathRef ref;
+        sta_->vertexWorstSlackPath(vert, sta::MinMax::max(), ref);
+        timings.slacks[i] = ref.tag(sta_) ? ref.slack(sta_) : sta::INF;
+
+        if (network()->direction(term)->isInput())
+        {
+            timings.slews[i] = std::max(
+                sta_->vertexSlew(vert, sta::RiseFall::rise(),
+                                 sta::MinMax::max()),
+                sta_->vertexSlew(vert, sta::RiseFall::fall(),
+                                 sta::MinMax::max()));
+        }
+        else
+        {
+            timings.slews[i] = slew(term);
+        }
+        timings.loads[i] = delay_calc->loadCap(term, cmdDcalcAnalysisPt());
+
+        float limit;
+        bool  limit_exists;
+        slewLimit(term, sta::MinMax::max(), limit, limit_exists);
+        timings.slew_limits[i]        = limit;
+        timings.capacitance_limits[i] = capacitanceLimit(term);
+        timings.violations[i] =
+            hasElectricalViolation(term, limit_scale_factor);
+    }
+}
+
+std::vector<float>
+DatabaseHandler::worstSlacks(const std::vector<InstanceTerm*>& terms) const
+{
+    sta_->ensureLevelized();
+    sta_->findRequireds();
+    std::vector<float> slacks(terms.size(), sta::INF);
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        auto vert = terms[i] ? vertex(terms[i]) : nullptr;
+        if (!vert)
+        {
+            continue;
+        }
+        sta::PathRef ref;
+        sta_->vertexWorstSlackPath(vert, sta::MinMax::max(), ref);
+        if (ref.tag(sta_))
+        {
+            slacks[i] = ref.slack(sta_);
+        }
+    }
+    return slacks;
+}
+
+std::vector<ElectircalViolation>
+DatabaseHandler::electricalViolations(const std::vector<InstanceTerm*>& terms,
+                                      float limit_scale_factor) const
+{
+    sta_->findDelays();
+    std::vector<ElectircalViolation> violations(terms.size(),
+                                                ElectircalViolation::None);
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        if (terms[i])
+        {
+            violations[i] =
+                hasElectricalViolation(terms[i], limit_scale_factor);
+        }
+    }
+    return violations;
+}
+
+void
+DatabaseHandler::buildViolationIndex(float limit_scale_factor)
+{
+    clearViolationIndex();
+    sta_->ensureGraph();
+    sta_->ensureLevelized();
+    sta_->findDelays();
+    has_violation_index_          = true;
+    violation_limit_scale_factor_ = limit_scale_factor;
+
+    auto                handler_network = network();
+    sta::VertexIterator itr(handler_network->graph());
+    while (itr.hasNext())
+    {
+        Vertex* vtx = itr.next();
+        if (vtx->isDriver(handler_network))
+        {
+            evaluateViolation(vtx->pin());
+        }
+    }
+}
+
+void
+DatabaseHandler::updateViolationIndex()
+{
+    if (!has_violation_index_)
+    {
+        return;
+    }
+    if (violation_index_stale_)
+    {
+        buildViolationIndex(violation_limit_scale_factor_);
+        return;
+    }
+    if (violation_dirty_nets_.empty() && violation_dirty_pins_.empty())
+    {
+        return;
+    }
+    sta_->findDelays();
+    // Re-evaluate the drivers of edited nets, then keep walking the fanout
+    // cone for as long as the worst slew on a re-evaluated net has changed,
+    // since a slew change propagates through every downstream gate.
+    std::vector<InstanceTerm*> worklist(violation_dirty_pins_.begin(),
+                                        violation_dirty_pins_.end());
+    std::unordered_set<InstanceTerm*> queued(worklist.begin(), worklist.end());
+    for (auto& dirty_net : violation_dirty_nets_)
+    {
+        auto driver = faninPin(dirty_net);
+        if (driver && queued.insert(driver).second)
+        {
+            worklist.push_back(driver);
+        }
+    }
+    violation_dirty_nets_.clear();
+    violation_dirty_pins_.clear();
+    while (!worklist.empty())
+    {
+        auto driver = worklist.back();
+        worklist.pop_back();
+        auto driver_net = net(driver);
+        if (!evaluateViolation(driver) || !driver_net)
+        {
+            continue;
+        }
+        for (auto& fanout_pin : fanoutPins(driver_net))
+        {
+            for (auto& out_pin : outputPins(network()->instance(fanout_pin)))
+            {
+                if (queued.insert(out_pin).second)
+                {
+                    worklist.push_back(out_pin);
+                }
+            }
+        }
+    }
+}
+
+void
+DatabaseHandler::clearViolationIndex()
+{
+    violation_index_.clear();
+    violation_order_.clear();
+    violation_slews_.clear();
+    violation_dirty_nets_.clear();
+    violation_dirty_pins_.clear();
+    has_violation_index_   = false;
+    violation_index_stale_ = false;
+}
+
+bool
+DatabaseHandler::hasViolationIndex() const
+{
+    return has_violation_index_;
+}
+
+ElectircalViolation
+DatabaseHandler::indexedViolation(InstanceTerm* driver)
+{
+    if (!has_violation_index_)
+    {
+        return hasElectricalViolation(driver);
+    }
+    updateViolationIndex();
+    auto itr = violation_index_.find(driver);
+    if (itr == violation_index_.end())
+    {
+        return ElectircalViolation::None;
+    }
+    return itr->second.second;
+}
+
+float
+DatabaseHandler::violationSeverity(InstanceTerm* driver)
+{
+    updateViolationIndex();
+    auto itr = violation_index_.find(driver);
+    if (itr == violation_index_.end())
+    {
+        return 0.0;
+    }
+    return itr->second.first;
+}
+
+std::vector<InstanceTerm*>
+DatabaseHandler::topViolations(int count, ElectircalViolation type)
+{
+    if (!has_violation_index_)
+    {
+        buildViolationIndex();
+    }
+    updateViolationIndex();
+    std::vector<InstanceTerm*> result;
+    for (auto itr = violation_order_.rbegin(); itr != violation_order_.rend();
+         itr++)
+    {
+        if (count > 0 && result.size() >= (size_t)count)
+        {
+            break;
+        }
+        auto vio = violation_index_[itr->second].second;
+        if (type == ElectircalViolation::CapacitanceAndTransition ||
+            vio == type || vio == ElectircalViolation::CapacitanceAndTransition)
+        {
+            result.push_back(itr->second);
+        }
+    }
+    return result;
+}
+
+// Returns true when the worst slew on the driver net differs from the one
+// recorded at the previous evaluation, so fanout drivers need a re-check.
+bool
+DatabaseHandler::evaluateViolation(InstanceTerm* driver)
+{
+    auto itr = violation_index_.find(driver);
+    if (itr != violation_index_.end())
+    {
+        violation_order_.erase(std::make_pair(itr->second.first, driver));
+        violation_index_.erase(itr);
+    }
+    auto driver_net = net(driver);
+    if (!driver_net || !isDriver(driver))
+    {
+        return violation_slews_.erase(driver) > 0;
+    }
+    float severity, max_slew;
+    auto  vio      = netViolation(driver_net, violation_limit_scale_factor_,
+                            &severity, &max_slew);
+    auto  slew_itr = violation_slews_.find(driver);
+    bool  changed  = slew_itr == violation_slews_.end() ||
+                   std::abs(slew_itr->second - max_slew) >
+                       1E-3F * std::max(slew_itr->second, max_slew);
+    violation_slews_[driver] = max_slew;
+    if (vio != ElectircalViolation::None)
+    {
+        violation_index_[driver] = std::make_pair(severity, vio);
+        violation_order_.insert(std::make_pair(severity, driver));
+    }
+    return changed;
+}
+
+void
+DatabaseHandler::invalidateNet(Net* net) const
+{
+    if (!net)
+    {
+        return;
+    }
+    if (has_violation_index_)
+    {
+        violation_dirty_nets_.insert(net);
+    }
+    if (has_power_cache_)
+    {
+        power_dirty_nets_.insert(net);
+    }
+}
+
+void
+DatabaseHandler::trackInstanceChange(Instance* inst)
+{
+    auto inst_name = name(inst);
+    if (!eco_changes_.added_instances.count(inst_name))
+    {
+        eco_changes_.modified_instances.insert(inst_name);
+    }
+}
+
+void
+DatabaseHandler::trackNetChange(Net* net) const
+{
+    if (!net)
+    {
+        return;
+    }
+    auto net_name = name(net);
+    eco_changes_.removed_nets.erase(net_name);
+    eco_changes_.modified_nets.insert(net_name);
+}
+
+const EcoChanges&
+DatabaseHandler::ecoChanges() const
+{
+    return eco_changes_;
+}
+
+void
+DatabaseHandler::clearEcoChanges()
+{
+    eco_changes_ = EcoChanges();
+}
+
+void
+DatabaseHandler::invalidatePin(InstanceTerm* term) const
+{
+    if (!term)
+    {
+        return;
+    }
+    if (has_violation_index_)
+    {
+        violation_dirty_pins_.insert(term);
+    }
+    auto inst = network()->instance(term);
+    if (has_power_cache_ && inst != network()->topInstance())
+    {
+        power_dirty_insts_.insert(inst);
+    }
+}
+
+void
+DatabaseHandler::invalidateInstance(Instance* inst) const
+{
+    if (!inst || inst == network()->topInstance())
+    {
+        return;
+    }
+    // Moving or resizing a cell changes the wire and pin loads of all its
+    // nets, which affects every driver and sink on them.
+    if (has_power_cache_)
+    {
+        power_dirty_insts_.insert(inst);
+    }
+    forEachPin(inst, [&](InstanceTerm* pin) { invalidateNet(net(pin)); });
+}
+
 bool
 DatabaseHandler::isLoad(InstanceTerm* term) const
 {
@@ -2972,6 +4070,7 @@ DatabaseHandler::resetCache()
     has_target_loads_        = false;
     maximum_area_valid_      = false;
     target_load_map_.clear();
+    resetNetlistCache();
     resetLibraryMapping();
 }
 void
@@ -3638,6 +4737,17 @@ DatabaseHandler::coreArea() const
     return dbuToMeters(core.dx()) * dbuToMeters(core.dy());
 }
 
+float
+DatabaseHandler::utilization() const
+{
+    float core_area = coreArea();
+    if (core_area <= 0.0)
+    {
+        return 0.0;
+    }
+    return area() / core_area;
+}
+
 bool
 DatabaseHandler::maximumUtilizationViolation() const
 {
@@ -3717,7 +4827,7 @@ DatabaseHandler::gateDelay(LibraryCell* lib_cell, InstanceTerm* to,
                             target_slews_[arc->toTrans()->asRiseFall()->index()];
                         sta_->arcDelayCalc()->gateDelay(
                             lib_cell, arc, in_slew, load_cap, nullptr, 0.0,
-                            pvt_, dcalc_ap_, gate_delay, *slew);
+                            cmdPvt(), cmdDcalcAnalysisPt(), gate_delay, *slew);
                         max = std::max(max, gate_delay);
                     }
                 }
@@ -3786,7 +4896,7 @@ DatabaseHandler::findTargetLoad(LibraryCell* cell, sta::TimingArc* arc,
         {
             sta::ArcDelay arc_delay;
             sta::Slew     arc_slew;
-            model->gateDelay(cell, pvt_, in_slew, load_cap, 0.0, false,
+            model->gateDelay(cell, cmdPvt(), in_slew, load_cap, 0.0, false,
                              arc_delay, arc_slew);
             if (arc_slew > out_slew)
             {
@@ -3891,6 +5001,13 @@ DatabaseHandler::gateDelay(InstanceTerm* pin, float load_cap, float* tr_slew)
 float
 DatabaseHandler::gateDelay(LibraryTerm* out_port, float load_cap,
                            float* tr_slew)
+{
+    return gateDelay(out_port, load_cap, tr_slew, cmdDcalcAnalysisPt());
+}
+
+float
+DatabaseHandler::gateDelay(LibraryTerm* out_port, float load_cap,
+                           float* tr_slew, const sta::DcalcAnalysisPt* dcalc_ap)
 {
     if (!has_target_loads_)
     {
@@ -3914,9 +5031,10 @@ DatabaseHandler::gateDelay(LibraryTerm* out_port, float load_cap,
                     tr_slew ? *tr_slew : target_slews_[in_rf->index()];
                 sta::ArcDelay gate_delay;
                 sta::Slew     drvr_slew;
-                sta_->arcDelayCalc()->gateDelay(cell, arc, in_slew, load_cap,
-                                                nullptr, 0.0, pvt_, dcalc_ap_,
-                                                gate_delay, drvr_slew);
+                sta_->arcDelayCalc()->gateDelay(
+                    cell, arc, in_slew, load_cap, nullptr, 0.0,
+                    dcalc_ap->operatingConditions(), dcalc_ap, gate_delay,
+                    drvr_slew);
                 max_delay = std::max(max_delay, gate_delay);
             }
         }
@@ -3932,6 +5050,59 @@ DatabaseHandler::bufferDelay(psn::LibraryCell* buffer_cell, float load_cap)
     return gateDelay(output, load_cap);
 }
 
+int
+DatabaseHandler::cornerCount() const
+{
+    return sta_->corners()->count();
+}
+
+const sta::Corner*
+DatabaseHandler::cmdCorner() const
+{
+    // Re-read on every use: makeCorners() deletes the previous corners.
+    return sta_->cmdCorner();
+}
+
+const sta::DcalcAnalysisPt*
+DatabaseHandler::cmdDcalcAnalysisPt() const
+{
+    return cmdCorner()->findDcalcAnalysisPt(min_max_);
+}
+
+const sta::Pvt*
+DatabaseHandler::cmdPvt() const
+{
+    return cmdDcalcAnalysisPt()->operatingConditions();
+}
+
+const sta::Corner*
+DatabaseHandler::findCorner(int corner_index) const
+{
+    if (corner_index < 0 || corner_index >= cornerCount())
+    {
+        return cmdCorner();
+    }
+    return sta_->corners()->findCorner(corner_index);
+}
+
+float
+DatabaseHandler::cornerGateDelay(LibraryTerm* out_port, float load_cap,
+                                 int corner_index)
+{
+    auto corner = findCorner(corner_index);
+    return gateDelay(out_port, load_cap, nullptr,
+                     corner->findDcalcAnalysisPt(min_max_));
+}
+
+float
+DatabaseHandler::cornerBufferDelay(psn::LibraryCell* buffer_cell,
+                                   float load_cap, int corner_index)
+{
+    psn::LibraryTerm *input, *output;
+    buffer_cell->bufferPorts(input, output);
+    return cornerGateDelay(output, load_cap, corner_index);
+}
+
 float
 DatabaseHandler::portCapacitance(const LibraryTerm* port, bool isMax) const
 {
@@ -4077,10 +5248,10 @@ DatabaseHandler::findBufferTargetSlews(Liberty* library,
                         float load_cap = in_cap * 10.0; // "factor debatable"
                         sta::ArcDelay arc_delay;
                         sta::Slew     arc_slew;
-                        model->gateDelay(buffer, pvt_, 0.0, load_cap, 0.0,
-                                         false, arc_delay, arc_slew);
-                        model->gateDelay(buffer, pvt_, arc_slew, load_cap, 0.0,
+                        model->gateDelay(buffer, cmdPvt(), 0.0, load_cap, 0.0,
                                          false, arc_delay, arc_slew);
+                        model->gateDelay(buffer, cmdPvt(), arc_slew, load_cap,
+                                         0.0, false, arc_delay, arc_slew);
                         slews[out_rf->index()] += arc_slew;
                         counts[out_rf->index()]++;
                     }
@@ -4124,6 +5295,7 @@ DatabaseHandler::isClock(Net* net) const
 void
 DatabaseHandler::calculateParasitics(Net* net)
 {
+    invalidateNet(net);
     if (compute_parasitics_callback_ != nullptr)
     {
         compute_parasitics_callback_(net);
@@ -4132,37 +5304,52 @@ DatabaseHandler::calculateParasitics(Net* net)
     auto tree = SteinerTree::create(net, psn_);
     if (tree && tree->isPlaced())
     {
-        sta::Parasitic* parasitic = sta_->parasitics()->makeParasiticNetwork(
-            net, false, parasitics_ap_);
-        int branch_count = tree->branchCount();
-        for (int i = 0; i < branch_count; i++)
+        // Corners may share a parasitic analysis point; build each one once.
+        std::unordered_set<const sta::ParasiticAnalysisPt*> parasitics_aps;
+        for (int i = 0; i < cornerCount(); i++)
         {
-            auto                branch = tree->branch(i);
-            sta::ParasiticNode* n1 =
-                findParasiticNode(tree, parasitic, net, branch.firstPin(),
-                                  branch.firstSteinerPoint());
-            sta::ParasiticNode* n2 =
-                findParasiticNode(tree, parasitic, net, branch.secondPin(),
-                                  branch.secondSteinerPoint());
-            if (n1 != n2)
+            auto parasitics_ap =
+                findCorner(i)->findParasiticAnalysisPt(min_max_);
+            if (parasitics_aps.insert(parasitics_ap).second)
             {
-                if (branch.wireLength() == 0)
-                {
-                    sta_->parasitics()->makeResistor(nullptr, n1, n2, 1.0e-3,
-                                                     parasitics_ap_);
-                }
-                else
-                {
-                    float wire_length = dbuToMeters(branch.wireLength());
-                    float wire_cap    = wire_length * cap_per_micron_;
-                    float wire_res    = wire_length * res_per_micron_;
-                    sta_->parasitics()->incrCap(n1, wire_cap / 2.0,
-                                                parasitics_ap_);
-                    sta_->parasitics()->makeResistor(nullptr, n1, n2, wire_res,
-                                                     parasitics_ap_);
-                    sta_->parasitics()->incrCap(n2, wire_cap / 2.0,
-                                                parasitics_ap_);
-                }
+                makeParasiticNetwork(net, tree, parasitics_ap);
+            }
+        }
+    }
+}
+void
+DatabaseHandler::makeParasiticNetwork(
+    Net* net, std::unique_ptr<SteinerTree>& tree,
+    const sta::ParasiticAnalysisPt* parasitics_ap)
+{
+    sta::Parasitic* parasitic =
+        sta_->parasitics()->makeParasiticNetwork(net, false, parasitics_ap);
+    int branch_count = tree->branchCount();
+    for (int i = 0; i < branch_count; i++)
+    {
+        auto                branch = tree->branch(i);
+        sta::ParasiticNode* n1 =
+            findParasiticNode(tree, parasitic, net, branch.firstPin(),
+                              branch.firstSteinerPoint());
+        sta::ParasiticNode* n2 =
+            findParasiticNode(tree, parasitic, net, branch.secondPin(),
+                              branch.secondSteinerPoint());
+        if (n1 != n2)
+        {
+            if (branch.wireLength() == 0)
+            {
+                sta_->parasitics()->makeResistor(nullptr, n1, n2, 1.0e-3,
+                                                 parasitics_ap);
+            }
+            else
+            {
+                float wire_length = dbuToMeters(branch.wireLength());
+                float wire_cap    = wire_length * cap_per_micron_;
+                float wire_res    = wire_length * res_per_micron_;
+                sta_->parasitics()->incrCap(n1, wire_cap / 2.0, parasitics_ap);
+                sta_->parasitics()->makeResistor(nullptr, n1, n2, wire_res,
+                                                 parasitics_ap);
+                sta_->parasitics()->incrCap(n2, wire_cap / 2.0, parasitics_ap);
             }
         }
     }
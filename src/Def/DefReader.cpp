@@ -36,8 +36,154 @@
 #include "PsnException/NoTechException.hpp"
 #include "PsnLogger/PsnLogger.hpp"
 
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <zlib.h>
+
 namespace psn
 {
+namespace
+{
+const size_t kInflateBufferSize = 1 << 20;
+
+bool
+isCompressed(const char* path)
+{
+    size_t length = std::strlen(path);
+    return length > 3 && !std::strcmp(path + length - 3, ".gz");
+}
+
+// Inflates a gzip file into a named pipe on a background thread, the DEF
+// parser reads the pipe while the rest of the file is decompressed.
+class DefInflater
+{
+public:
+    DefInflater(const char* path) : path_(path), failed_(false)
+    {
+        char dir_template[] = "/tmp/psn_def_XXXXXX";
+        if (!mkdtemp(dir_template))
+        {
+            throw FileException();
+        }
+        dir_       = dir_template;
+        pipe_path_ = dir_ + "/design.def";
+        if (mkfifo(pipe_path_.c_str(), 0600) != 0)
+        {
+            rmdir(dir_.c_str());
+            throw FileException();
+        }
+        thread_ = std::thread(&DefInflater::inflate, this);
+    }
+    ~DefInflater()
+    {
+        finish();
+        unlink(pipe_path_.c_str());
+        rmdir(dir_.c_str());
+    }
+    // Waits for the writer, unblocking it if the parser never opened or
+    // drained the pipe; further writes then fail with EPIPE.
+    void
+    finish()
+    {
+        if (!thread_.joinable())
+        {
+            return;
+        }
+        int fd = open(pipe_path_.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        thread_.join();
+    }
+    const char*
+    pipePath() const
+    {
+        return pipe_path_.c_str();
+    }
+    bool
+    failed() const
+    {
+        return failed_;
+    }
+
+private:
+    void
+    inflate()
+    {
+        // Report a closed pipe through EPIPE instead of terminating.
+        sigset_t pipe_signal;
+        sigemptyset(&pipe_signal);
+        sigaddset(&pipe_signal, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipe_signal, nullptr);
+
+        // Open the pipe first so the parser sees an empty file rather than
+        // blocking if the input cannot be opened.
+        int    out = open(pipe_path_.c_str(), O_WRONLY);
+        gzFile in  = out < 0 ? nullptr : gzopen(path_.c_str(), "rb");
+        if (!in || out < 0)
+        {
+            failed_ = true;
+        }
+        else
+        {
+            gzbuffer(in, kInflateBufferSize);
+            std::vector<char> buffer(kInflateBufferSize);
+            int               count;
+            while (!failed_ &&
+                   (count = gzread(in, buffer.data(), buffer.size())) > 0)
+            {
+                const char* data = buffer.data();
+                while (count > 0)
+                {
+                    ssize_t written = write(out, data, count);
+                    if (written < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (written <= 0)
+                    {
+                        failed_ = true;
+                        break;
+                    }
+                    data += written;
+                    count -= written;
+                }
+            }
+            // A truncated stream ends with a zero count and a buffer error.
+            int error = Z_OK;
+            gzerror(in, &error);
+            if (count < 0 || (error != Z_OK && error != Z_STREAM_END))
+            {
+                failed_ = true;
+            }
+        }
+        if (in)
+        {
+            gzclose(in);
+        }
+        if (out >= 0)
+        {
+            close(out);
+        }
+    }
+
+    std::string       path_;
+    std::string       dir_;
+    std::string       pipe_path_;
+    std::thread       thread_;
+    std::atomic<bool> failed_;
+};
+} // namespace
 
 DefReader::DefReader(Database* db) : db_(db), parser_(db)
 {
@@ -62,8 +208,51 @@ DefReader::read(const char* path)
     {
         throw NoTechException();
     }
-    parser_.createChip(libs, path);
+    if (isCompressed(path))
+    {
+        readCompressed(libs, path);
+    }
+    else
+    {
+        readPlain(libs, path);
+    }
     return 1;
 }
 
+void
+DefReader::readPlain(std::vector<Library*>& libs, const char* path)
+{
+    // The parser reads through stdio, so ask the kernel to read the whole
+    // file ahead into the page cache instead.
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0)
+    {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    }
+    parser_.createChip(libs, path);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+void
+DefReader::readCompressed(std::vector<Library*>& libs, const char* path)
+{
+    PSN_LOG_DEBUG("Decompressing {} while parsing", path);
+    DefInflater inflater(path);
+    parser_.createChip(libs, inflater.pipePath());
+    inflater.finish();
+    if (inflater.failed())
+    {
+        PSN_LOG_ERROR("Failed to decompress {}", path);
+        if (db_->getChip())
+        {
+            odb::dbChip::destroy(db_->getChip());
+        }
+        throw FileException();
+    }
+}
+
 } // namespace psn
\ No newline at end of file
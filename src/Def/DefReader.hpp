@@ -34,15 +34,21 @@
 #include "OpenPhySyn/Database/Types.hpp"
 #include "opendb/defin.h"
 
+#include <vector>
+
 namespace psn
 {
 class DefReader
 {
 public:
     DefReader(Database* db);
+    // Reads plain or gzip-compressed (.def.gz) DEF files.
     int read(const char* path);
 
 private:
+    void readPlain(std::vector<Library*>& libs, const char* path);
+    void readCompressed(std::vector<Library*>& libs, const char* path);
+
     Database* db_;
     DefParser parser_;
 };
@@ -0,0 +1,212 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include "EcoReader.hpp"
+#include "OpenPhySyn/Sta/DatabaseStaNetwork.hpp"
+#include "PsnException/FileException.hpp"
+#include "PsnLogger/PsnLogger.hpp"
+
+#include <fstream>
+#include <string>
+
+namespace psn
+{
+
+// Reads a name written by EcoWriter; version 1 files have bare names.
+static bool
+readName(std::istream& in, std::string& name)
+{
+    name.clear();
+    if (!(in >> std::ws) || in.peek() != '"')
+    {
+        return static_cast<bool>(in >> name);
+    }
+    in.get();
+    char c;
+    while (in.get(c))
+    {
+        if (c == '"')
+        {
+            return true;
+        }
+        if (c == '\\' && !in.get(c))
+        {
+            break;
+        }
+        name += c;
+    }
+    return false;
+}
+
+EcoReader::EcoReader(DatabaseHandler* handler) : handler_(handler)
+{
+}
+
+int
+EcoReader::read(const char* path)
+{
+    std::ifstream in(path);
+    if (!in.is_open())
+    {
+        throw FileException();
+    }
+    std::string keyword;
+    int         version = 0;
+    if (!(in >> keyword >> version) || keyword != "PSN_ECO" || version < 1 ||
+        version > 2)
+    {
+        PSN_LOG_ERROR("{} is not a supported ECO file", path);
+        return -1;
+    }
+    int count = 0;
+    while (in >> keyword)
+    {
+        if (keyword == "END")
+        {
+            PSN_LOG_INFO("Applied {} ECO changes from {}", count, path);
+            return count;
+        }
+        else if (keyword == "DESIGN")
+        {
+            std::string design_name;
+            readName(in, design_name);
+            if (design_name != handler_->topName())
+            {
+                PSN_LOG_WARN("ECO file was written for {}, applying it to {}",
+                             design_name, handler_->topName());
+            }
+            continue;
+        }
+        else if (keyword == "REMOVE_INST")
+        {
+            std::string inst_name;
+            readName(in, inst_name);
+            Instance* inst = handler_->instance(inst_name.c_str());
+            if (inst)
+            {
+                handler_->del(inst);
+            }
+        }
+        else if (keyword == "INST")
+        {
+            std::string inst_name, cell_name, orient, status;
+            int         x, y;
+            if (!readName(in, inst_name) || !readName(in, cell_name) ||
+                !(in >> x >> y >> orient >> status))
+            {
+                break;
+            }
+            LibraryCell* cell = handler_->libraryCell(cell_name.c_str());
+            if (!cell)
+            {
+                PSN_LOG_ERROR("Cannot find cell {} for {}", cell_name,
+                              inst_name);
+                return -1;
+            }
+            Instance* inst = handler_->instance(inst_name.c_str());
+            if (!inst)
+            {
+                inst = handler_->createInstance(inst_name.c_str(), cell);
+            }
+            else if (handler_->libraryCell(inst) != cell)
+            {
+                handler_->replaceInstance(inst, cell);
+                inst = handler_->instance(inst_name.c_str());
+            }
+            handler_->setPlacement(inst, Point(x, y), orient.c_str(),
+                                   status.c_str());
+        }
+        else if (keyword == "NET")
+        {
+            std::string net_name;
+            readName(in, net_name);
+            Net* net = handler_->net(net_name.c_str());
+            if (!net)
+            {
+                net = handler_->createNet(net_name.c_str());
+            }
+            handler_->disconnectAll(net);
+            while (in >> keyword && keyword != "END_NET")
+            {
+                InstanceTerm* term = nullptr;
+                if (keyword == "PIN")
+                {
+                    std::string inst_name, port_name;
+                    readName(in, inst_name);
+                    readName(in, port_name);
+                    Instance* inst = handler_->instance(inst_name.c_str());
+                    if (inst)
+                    {
+                        term = handler_->network()->findPin(
+                            inst, port_name.c_str());
+                    }
+                }
+                else if (keyword == "PORT")
+                {
+                    std::string port_name;
+                    readName(in, port_name);
+                    term = handler_->port(port_name.c_str());
+                }
+                if (!term)
+                {
+                    PSN_LOG_ERROR("Cannot find pin {} of net {}", keyword,
+                                  net_name);
+                    return -1;
+                }
+                if (handler_->net(term))
+                {
+                    handler_->disconnect(term);
+                }
+                handler_->connect(net, term);
+            }
+        }
+        else if (keyword == "REMOVE_NET")
+        {
+            std::string net_name;
+            readName(in, net_name);
+            Net* net = handler_->net(net_name.c_str());
+            if (net)
+            {
+                handler_->disconnectAll(net);
+                handler_->del(net);
+            }
+        }
+        else
+        {
+            PSN_LOG_ERROR("Unexpected {} in ECO file {}", keyword, path);
+            return -1;
+        }
+        count++;
+    }
+    PSN_LOG_ERROR("Truncated ECO file {}", path);
+    return -1;
+}
+
+} // namespace psn
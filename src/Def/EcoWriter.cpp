@@ -0,0 +1,153 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include "EcoWriter.hpp"
+#include "OpenPhySyn/Sta/DatabaseStaNetwork.hpp"
+#include "PsnException/FileException.hpp"
+#include "PsnLogger/PsnLogger.hpp"
+#include "opendb/db.h"
+
+#include <fstream>
+#include <string>
+
+namespace psn
+{
+
+static std::string
+quoted(const std::string& name)
+{
+    std::string result = "\"";
+    for (auto c : name)
+    {
+        if (c == '"' || c == '\\')
+        {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + "\"";
+}
+
+EcoWriter::EcoWriter(DatabaseHandler* handler) : handler_(handler)
+{
+}
+
+int
+EcoWriter::write(const char* path)
+{
+    std::ofstream out(path);
+    if (!out.is_open())
+    {
+        throw FileException();
+    }
+    auto& changes = handler_->ecoChanges();
+    int   count   = 0;
+    out << "PSN_ECO 2\n";
+    out << "DESIGN " << quoted(handler_->topName()) << "\n";
+    for (auto& inst_name : changes.removed_instances)
+    {
+        if (!handler_->instance(inst_name.c_str()))
+        {
+            out << "REMOVE_INST " << quoted(inst_name) << "\n";
+            count++;
+        }
+    }
+    for (auto inst_names :
+         {&changes.added_instances, &changes.modified_instances})
+    {
+        for (auto& inst_name : *inst_names)
+        {
+            Instance* inst = handler_->instance(inst_name.c_str());
+            if (inst)
+            {
+                writeInstance(out, inst);
+                count++;
+            }
+        }
+    }
+    for (auto& net_name : changes.modified_nets)
+    {
+        Net* net = handler_->net(net_name.c_str());
+        if (net)
+        {
+            writeNet(out, net);
+            count++;
+        }
+    }
+    for (auto& net_name : changes.removed_nets)
+    {
+        if (!handler_->net(net_name.c_str()))
+        {
+            out << "REMOVE_NET " << quoted(net_name) << "\n";
+            count++;
+        }
+    }
+    out << "END\n";
+    if (!out)
+    {
+        throw FileException();
+    }
+    PSN_LOG_INFO("Wrote {} ECO changes to {}", count, path);
+    return count;
+}
+
+void
+EcoWriter::writeInstance(std::ostream& out, Instance* inst) const
+{
+    auto  db_inst = handler_->network()->staToDb(inst);
+    Point loc     = handler_->location(inst);
+    out << "INST " << quoted(handler_->name(inst)) << " "
+        << quoted(handler_->name(handler_->libraryCell(inst))) << " "
+        << loc.getX() << " " << loc.getY() << " "
+        << db_inst->getOrient().getString() << " "
+        << db_inst->getPlacementStatus().getString() << "\n";
+}
+
+void
+EcoWriter::writeNet(std::ostream& out, Net* net) const
+{
+    out << "NET " << quoted(handler_->name(net)) << "\n";
+    for (auto& pin : handler_->pins(net))
+    {
+        if (handler_->isTopLevel(pin))
+        {
+            out << "  PORT " << quoted(handler_->name(pin)) << "\n";
+        }
+        else
+        {
+            out << "  PIN " << quoted(handler_->name(handler_->instance(pin)))
+                << " " << quoted(handler_->name(handler_->libraryPin(pin)))
+                << "\n";
+        }
+    }
+    out << "END_NET\n";
+}
+
+} // namespace psn
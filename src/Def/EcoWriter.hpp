@@ -0,0 +1,69 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "OpenPhySyn/Database/DatabaseHandler.hpp"
+#include "OpenPhySyn/Database/Types.hpp"
+
+#include <ostream>
+
+namespace psn
+{
+// Writes the netlist edits recorded by the handler as a line-based ECO file:
+//
+//   PSN_ECO 2
+//   DESIGN <top>
+//   REMOVE_INST <instance>
+//   INST <instance> <cell> <x> <y> <orient> <placement status>
+//   NET <net>
+//     PIN <instance> <port>
+//     PORT <top port>
+//   END_NET
+//   REMOVE_NET <net>
+//   END
+//
+// Added, resized and moved instances are written with their final cell and
+// placement, modified nets with their full connection list. Names are double
+// quoted, with quotes and backslashes inside them escaped by a backslash.
+class EcoWriter
+{
+public:
+    EcoWriter(DatabaseHandler* handler);
+    int write(const char* path);
+
+private:
+    void writeInstance(std::ostream& out, Instance* inst) const;
+    void writeNet(std::ostream& out, Net* net) const;
+
+    DatabaseHandler* handler_;
+};
+} // namespace psn
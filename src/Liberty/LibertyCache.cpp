@@ -0,0 +1,831 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "LibertyCache.hpp"
+#include "OpenSTA/liberty/LibertyBuilder.hh"
+#include "OpenSTA/liberty/LibertyReaderPvt.hh"
+#include "PsnException/ParseLibertyException.hpp"
+#include "PsnLogger/PsnLogger.hpp"
+#include "Utils/FileUtils.hpp"
+#include "sta/Network.hh"
+#include "sta/StringUtil.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+namespace psn
+{
+namespace
+{
+const char     kCacheMagic[8]     = {'P', 'S', 'N', 'L', 'I', 'B', 'C', '\0'};
+const uint32_t kCacheVersion      = 3;
+const char*    kCacheExtension    = ".psnlib";
+const size_t   kHashBufferSize    = 1 << 20;
+const int64_t  kMtimeGranularity  = 2000000000; // Coarsest file system, in ns
+const uint64_t kFnvOffsetBasis    = 14695981039346656037ULL;
+const uint64_t kFnvPrime          = 1099511628211ULL;
+const uint8_t  kStringValue       = 's';
+const uint8_t  kFloatValue        = 'f';
+const int32_t  kNullValueSequence = -1;
+
+enum class LibertyStatement : uint8_t
+{
+    GroupBegin = 1,
+    GroupEnd,
+    SimpleAttribute,
+    ComplexAttribute,
+    Variable
+};
+
+struct LibertyCacheHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t float_size;
+    uint64_t size;
+    int64_t  mtime;
+    uint64_t hash;
+    uint64_t content_hash;
+    int64_t  written; // Time the image was written, in ns
+    uint64_t image_size;
+};
+
+int64_t
+nowNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+class LibertyImageReader
+{
+public:
+    LibertyImageReader(const std::string& image) : image_(image), pos_(0)
+    {
+    }
+    bool
+    atEnd() const
+    {
+        return pos_ >= image_.size();
+    }
+    uint8_t
+    readByte()
+    {
+        uint8_t value;
+        read(&value, sizeof(value));
+        return value;
+    }
+    int32_t
+    readInt()
+    {
+        int32_t value;
+        read(&value, sizeof(value));
+        return value;
+    }
+    float
+    readFloat()
+    {
+        float value;
+        read(&value, sizeof(value));
+        return value;
+    }
+    // Returns a heap copy owned by the liberty statement it is passed to.
+    const char*
+    readString()
+    {
+        int32_t length = readInt();
+        if (length < 0 || pos_ + length > image_.size())
+        {
+            throw ParseLibertyException("Corrupted liberty cache image");
+        }
+        std::string value = image_.substr(pos_, length);
+        pos_ += length;
+        return sta::stringCopy(value.c_str());
+    }
+    sta::LibertyAttrValue*
+    readValue()
+    {
+        uint8_t kind = readByte();
+        if (kind == kFloatValue)
+        {
+            return new sta::LibertyFloatAttrValue(readFloat());
+        }
+        if (kind == kStringValue)
+        {
+            return new sta::LibertyStringAttrValue(readString());
+        }
+        throw ParseLibertyException("Corrupted liberty cache image");
+    }
+    sta::LibertyAttrValueSeq*
+    readValues()
+    {
+        int32_t count = readInt();
+        if (count == kNullValueSequence)
+        {
+            return nullptr;
+        }
+        sta::LibertyAttrValueSeq* values = new sta::LibertyAttrValueSeq;
+        for (int32_t i = 0; i < count; i++)
+        {
+            values->push_back(readValue());
+        }
+        return values;
+    }
+
+private:
+    void
+    read(void* value, size_t size)
+    {
+        if (pos_ + size > image_.size())
+        {
+            throw ParseLibertyException("Corrupted liberty cache image");
+        }
+        std::memcpy(value, image_.data() + pos_, size);
+        pos_ += size;
+    }
+
+    const std::string& image_;
+    size_t             pos_;
+};
+
+// OpenSTA liberty reader that either records the statements it visits while
+// parsing the text file, or is driven by a recorded image.
+class CachedLibertyReader : public sta::LibertyReader
+{
+public:
+    CachedLibertyReader(sta::LibertyBuilder* builder)
+        : sta::LibertyReader(builder), writer_(nullptr)
+    {
+    }
+    sta::LibertyLibrary*
+    record(const char* path, bool infer_latches, sta::Network* network,
+           LibertyImageWriter* writer)
+    {
+        writer_                      = writer;
+        sta::LibertyLibrary* library = nullptr;
+        try
+        {
+            library = readLibertyFile(path, infer_latches, network);
+        }
+        catch (...)
+        {
+            writer_ = nullptr;
+            throw;
+        }
+        writer_ = nullptr;
+        return library;
+    }
+    // Mirrors the statement ownership rules of the liberty parser.
+    sta::LibertyLibrary*
+    replay(const char* path, bool infer_latches, sta::Network* network,
+           const std::string& image)
+    {
+        init(path, infer_latches, network);
+        LibertyImageReader              reader(image);
+        std::vector<sta::LibertyGroup*> groups;
+        try
+        {
+            while (!reader.atEnd())
+            {
+                replayStatement(reader, groups);
+            }
+        }
+        catch (...)
+        {
+            for (auto it = groups.rbegin(); it != groups.rend(); it++)
+            {
+                delete *it;
+            }
+            throw;
+        }
+        if (!groups.empty())
+        {
+            for (auto it = groups.rbegin(); it != groups.rend(); it++)
+            {
+                delete *it;
+            }
+            throw ParseLibertyException("Truncated liberty cache image");
+        }
+        return findLibrary(network, path);
+    }
+    virtual void
+    begin(sta::LibertyGroup* group) override
+    {
+        if (writer_)
+        {
+            writer_->beginGroup(group);
+        }
+        sta::LibertyReader::begin(group);
+    }
+    virtual void
+    end(sta::LibertyGroup* group) override
+    {
+        if (writer_)
+        {
+            writer_->endGroup();
+        }
+        sta::LibertyReader::end(group);
+    }
+    virtual void
+    visitAttr(sta::LibertyAttr* attr) override
+    {
+        if (writer_)
+        {
+            writer_->attribute(attr);
+        }
+        sta::LibertyReader::visitAttr(attr);
+    }
+    virtual void
+    visitVariable(sta::LibertyVariable* variable) override
+    {
+        if (writer_)
+        {
+            writer_->variable(variable);
+        }
+        sta::LibertyReader::visitVariable(variable);
+    }
+
+private:
+    // The library made by the replayed statements, looked up through the
+    // network rather than the reader state.
+    static sta::LibertyLibrary*
+    findLibrary(sta::Network* network, const char* path)
+    {
+        sta::LibertyLibrary*         library = nullptr;
+        sta::LibertyLibraryIterator* lib_iter =
+            network->libertyLibraryIterator();
+        while (lib_iter->hasNext())
+        {
+            auto lib = lib_iter->next();
+            if (lib->filename() && !std::strcmp(lib->filename(), path))
+            {
+                library = lib;
+            }
+        }
+        delete lib_iter;
+        return library;
+    }
+    void
+    replayStatement(LibertyImageReader&              reader,
+                    std::vector<sta::LibertyGroup*>& groups)
+    {
+        sta::LibertyGroup* parent = groups.empty() ? nullptr : groups.back();
+        LibertyStatement   statement =
+            static_cast<LibertyStatement>(reader.readByte());
+        switch (statement)
+        {
+        case LibertyStatement::GroupBegin:
+        {
+            const char*               type   = reader.readString();
+            sta::LibertyAttrValueSeq* params = reader.readValues();
+            int                       line   = reader.readInt();
+            sta::LibertyGroup* group = new sta::LibertyGroup(type, params, line);
+            groups.push_back(group);
+            begin(group);
+            break;
+        }
+        case LibertyStatement::GroupEnd:
+        {
+            if (!parent)
+            {
+                throw ParseLibertyException("Corrupted liberty cache image");
+            }
+            end(parent);
+            groups.pop_back();
+            sta::LibertyGroup* grand_parent =
+                groups.empty() ? nullptr : groups.back();
+            if (grand_parent && save(parent))
+            {
+                grand_parent->addSubgroup(parent);
+            }
+            else
+            {
+                delete parent;
+            }
+            break;
+        }
+        case LibertyStatement::SimpleAttribute:
+        case LibertyStatement::ComplexAttribute:
+        {
+            const char*       name = reader.readString();
+            sta::LibertyAttr* attr = nullptr;
+            if (statement == LibertyStatement::SimpleAttribute)
+            {
+                sta::LibertyAttrValue* value = reader.readValue();
+                attr = new sta::LibertySimpleAttr(name, value, reader.readInt());
+            }
+            else
+            {
+                sta::LibertyAttrValueSeq* values = reader.readValues();
+                attr =
+                    new sta::LibertyComplexAttr(name, values, reader.readInt());
+            }
+            visitAttr(attr);
+            if (parent && save(attr))
+            {
+                parent->addAttribute(attr);
+            }
+            else
+            {
+                delete attr;
+            }
+            break;
+        }
+        case LibertyStatement::Variable:
+        {
+            const char* name     = reader.readString();
+            float       value    = reader.readFloat();
+            int         line     = reader.readInt();
+            auto        variable = new sta::LibertyVariable(name, value, line);
+            visitVariable(variable);
+            if (parent && save(variable))
+            {
+                parent->addVariable(variable);
+            }
+            else
+            {
+                delete variable;
+            }
+            break;
+        }
+        default:
+            throw ParseLibertyException("Corrupted liberty cache image");
+        }
+    }
+
+    LibertyImageWriter* writer_;
+};
+} // namespace
+
+void
+LibertyImageWriter::beginGroup(sta::LibertyGroup* group)
+{
+    writeByte(static_cast<uint8_t>(LibertyStatement::GroupBegin));
+    writeString(group->type());
+    writeValues(group->params());
+    writeInt(group->line());
+}
+
+void
+LibertyImageWriter::endGroup()
+{
+    writeByte(static_cast<uint8_t>(LibertyStatement::GroupEnd));
+}
+
+void
+LibertyImageWriter::attribute(sta::LibertyAttr* attr)
+{
+    if (attr->isSimple())
+    {
+        writeByte(static_cast<uint8_t>(LibertyStatement::SimpleAttribute));
+        writeString(attr->name());
+        writeValue(attr->firstValue());
+    }
+    else
+    {
+        writeByte(static_cast<uint8_t>(LibertyStatement::ComplexAttribute));
+        writeString(attr->name());
+        writeValues(attr->values());
+    }
+    writeInt(attr->line());
+}
+
+void
+LibertyImageWriter::variable(sta::LibertyVariable* variable)
+{
+    writeByte(static_cast<uint8_t>(LibertyStatement::Variable));
+    writeString(variable->variable());
+    writeFloat(variable->value());
+    writeInt(variable->line());
+}
+
+const std::string&
+LibertyImageWriter::image() const
+{
+    return image_;
+}
+
+void
+LibertyImageWriter::writeByte(uint8_t value)
+{
+    image_.push_back(static_cast<char>(value));
+}
+
+void
+LibertyImageWriter::writeInt(int32_t value)
+{
+    image_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+LibertyImageWriter::writeFloat(float value)
+{
+    image_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+LibertyImageWriter::writeString(const char* value)
+{
+    int32_t length = value ? std::strlen(value) : 0;
+    writeInt(length);
+    image_.append(value ? value : "", length);
+}
+
+void
+LibertyImageWriter::writeValue(sta::LibertyAttrValue* value)
+{
+    if (value && value->isFloat())
+    {
+        writeByte(kFloatValue);
+        writeFloat(value->floatValue());
+    }
+    else
+    {
+        writeByte(kStringValue);
+        writeString(value ? value->stringValue() : nullptr);
+    }
+}
+
+void
+LibertyImageWriter::writeValues(sta::LibertyAttrValueSeq* values)
+{
+    if (!values)
+    {
+        writeInt(kNullValueSequence);
+        return;
+    }
+    writeInt(values->size());
+    for (auto value : *values)
+    {
+        writeValue(value);
+    }
+}
+
+void
+LibertyStatementRecorder::begin(sta::LibertyGroup* group)
+{
+    writer_.beginGroup(group);
+}
+
+void
+LibertyStatementRecorder::end(sta::LibertyGroup*)
+{
+    writer_.endGroup();
+}
+
+void
+LibertyStatementRecorder::visitAttr(sta::LibertyAttr* attr)
+{
+    writer_.attribute(attr);
+}
+
+void
+LibertyStatementRecorder::visitVariable(sta::LibertyVariable* variable)
+{
+    writer_.variable(variable);
+}
+
+bool
+LibertyStatementRecorder::save(sta::LibertyGroup*)
+{
+    return false;
+}
+
+bool
+LibertyStatementRecorder::save(sta::LibertyAttr*)
+{
+    return false;
+}
+
+bool
+LibertyStatementRecorder::save(sta::LibertyVariable*)
+{
+    return false;
+}
+
+const std::string&
+LibertyStatementRecorder::image() const
+{
+    return writer_.image();
+}
+
+LibertyCache::LibertyCache(const std::string& cache_dir, bool validate)
+    : cache_dir_(cache_dir), validate_(validate)
+{
+}
+
+sta::LibertyLibrary*
+LibertyCache::read(const char* path, bool infer_latches, sta::Network* network)
+{
+    sta::LibertyBuilder builder;
+    CachedLibertyReader reader(&builder);
+    LibertyCacheEntry   entry;
+    auto                prefetched = prefetched_.find(path);
+    if (prefetched != prefetched_.end())
+    {
+        entry = std::move(prefetched->second);
+        prefetched_.erase(prefetched);
+    }
+    else
+    {
+        entry = lookup(path);
+    }
+    if (!entry.has_key)
+    {
+        PSN_LOG_WARN("Failed to read {}, skipping liberty cache", path);
+        return reader.readLibertyFile(path, infer_latches, network);
+    }
+    const std::string& cache_path = entry.cache_path;
+    std::string&       image      = entry.image;
+    switch (entry.status)
+    {
+    case LibertyImageStatus::Incompatible:
+        PSN_LOG_DEBUG("Ignoring incompatible liberty cache {}", cache_path);
+        break;
+    case LibertyImageStatus::Stale:
+        PSN_LOG_DEBUG("Ignoring stale liberty cache {}", cache_path);
+        break;
+    case LibertyImageStatus::Truncated:
+        PSN_LOG_WARN("Ignoring truncated liberty cache {}", cache_path);
+        break;
+    default:
+        break;
+    }
+    if (entry.status == LibertyImageStatus::Loaded)
+    {
+        PSN_LOG_DEBUG("Loading {} from liberty cache {}", path, cache_path);
+        if (validate_)
+        {
+            LibertyStatementRecorder recorder;
+            sta::parseLibertyFile(path, &recorder, network->report());
+            if (recorder.image() == image)
+            {
+                PSN_LOG_INFO("Liberty cache {} matches {}", cache_path, path);
+            }
+            else
+            {
+                PSN_LOG_WARN("Liberty cache {} does not match {} ({} vs {} "
+                             "bytes), rewriting it",
+                             cache_path, path, image.size(),
+                             recorder.image().size());
+                image = recorder.image();
+                writeImage(cache_path, path, entry.key, image);
+            }
+        }
+        else if (entry.outdated_header)
+        {
+            // The file was touched but not changed; record the new metadata
+            // so the next lookup takes the fast path again.
+            writeImage(cache_path, path, entry.key, image);
+        }
+        return reader.replay(path, infer_latches, network, image);
+    }
+    PSN_LOG_DEBUG("Liberty cache miss for {}", path);
+    // Hashed before parsing, so an edit made meanwhile fails the next check.
+    computeContentHash(path, entry.key);
+    LibertyImageWriter   writer;
+    sta::LibertyLibrary* library =
+        reader.record(path, infer_latches, network, &writer);
+    if (library)
+    {
+        writeImage(cache_path, path, entry.key, writer.image());
+    }
+    return library;
+}
+
+void
+LibertyCache::prefetch(const std::vector<std::string>& paths)
+{
+    std::vector<LibertyCacheEntry> entries(paths.size());
+    size_t                         thread_count =
+        std::min<size_t>(paths.size(), std::thread::hardware_concurrency());
+    thread_count = std::max<size_t>(thread_count, 1);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t i = t; i < paths.size(); i += thread_count)
+            {
+                entries[i] = lookup(paths[i].c_str());
+            }
+        }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        prefetched_[paths[i]] = std::move(entries[i]);
+    }
+}
+
+std::string
+LibertyCache::cachePath(const char* path, const LibertyCacheKey& key) const
+{
+    char hash_str[17];
+    std::snprintf(hash_str, sizeof(hash_str), "%016llx",
+                  static_cast<unsigned long long>(key.hash));
+    return FileUtils::joinPath(cache_dir_, FileUtils::baseName(path) + "." +
+                                               hash_str + kCacheExtension);
+}
+
+bool
+LibertyCache::computeKey(const char* path, LibertyCacheKey& key)
+{
+    // Only the file metadata is read, so a lookup does not scan the library;
+    // readImage() falls back to the content hash when the metadata is not
+    // conclusive.
+    struct stat file_stat;
+    if (stat(path, &file_stat) != 0)
+    {
+        return false;
+    }
+    char        resolved[PATH_MAX];
+    const char* identity = realpath(path, resolved) ? resolved : path;
+    key.size  = file_stat.st_size;
+    key.mtime = static_cast<int64_t>(file_stat.st_mtim.tv_sec) * 1000000000 +
+                file_stat.st_mtim.tv_nsec;
+    key.hash  = kFnvOffsetBasis;
+    for (const char* c = identity; *c; c++)
+    {
+        key.hash = (key.hash ^ static_cast<unsigned char>(*c)) * kFnvPrime;
+    }
+    key.content_hash     = 0;
+    key.has_content_hash = false;
+    return true;
+}
+
+bool
+LibertyCache::computeContentHash(const char* path, LibertyCacheKey& key)
+{
+    if (key.has_content_hash)
+    {
+        return true;
+    }
+    FILE* file = std::fopen(path, "rb");
+    if (!file)
+    {
+        return false;
+    }
+    uint64_t                   hash = kFnvOffsetBasis;
+    std::vector<unsigned char> buffer(kHashBufferSize);
+    size_t                     count;
+    while ((count = std::fread(buffer.data(), 1, buffer.size(), file)) > 0)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            hash = (hash ^ buffer[i]) * kFnvPrime;
+        }
+    }
+    bool success = !std::ferror(file);
+    std::fclose(file);
+    if (success)
+    {
+        key.content_hash     = hash;
+        key.has_content_hash = true;
+    }
+    return success;
+}
+
+LibertyCacheEntry
+LibertyCache::lookup(const char* path) const
+{
+    LibertyCacheEntry entry;
+    entry.status          = LibertyImageStatus::Missing;
+    entry.outdated_header = false;
+    entry.has_key         = computeKey(path, entry.key);
+    if (entry.has_key)
+    {
+        entry.cache_path = cachePath(path, entry.key);
+        entry.status = readImage(entry.cache_path, path, entry.key, entry.image,
+                                 entry.outdated_header);
+    }
+    return entry;
+}
+
+LibertyImageStatus
+LibertyCache::readImage(const std::string& cache_path, const char* path,
+                        LibertyCacheKey& key, std::string& image,
+                        bool& outdated_header)
+{
+    std::ifstream      in(cache_path, std::ios::binary);
+    LibertyCacheHeader header;
+    if (!in.is_open() ||
+        !in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        return LibertyImageStatus::Missing;
+    }
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) ||
+        header.version != kCacheVersion || header.float_size != sizeof(float))
+    {
+        return LibertyImageStatus::Incompatible;
+    }
+    if (header.size != key.size || header.hash != key.hash)
+    {
+        return LibertyImageStatus::Stale;
+    }
+    // The mtime only proves the file unchanged if it matches and is older
+    // than the time stamp granularity, both when the image was written and
+    // now; otherwise an edit may hide behind the same mtime.
+    if (header.mtime != key.mtime ||
+        key.mtime + kMtimeGranularity >= header.written ||
+        key.mtime + kMtimeGranularity >= nowNanoseconds())
+    {
+        if (!computeContentHash(path, key) ||
+            header.content_hash != key.content_hash)
+        {
+            return LibertyImageStatus::Stale;
+        }
+        outdated_header = header.mtime != key.mtime;
+    }
+    image.resize(header.image_size);
+    if (!in.read(&image[0], header.image_size))
+    {
+        image.clear();
+        return LibertyImageStatus::Truncated;
+    }
+    return LibertyImageStatus::Loaded;
+}
+
+bool
+LibertyCache::writeImage(const std::string& cache_path, const char* path,
+                         LibertyCacheKey& key, const std::string& image) const
+{
+    if (!FileUtils::createDirectoryIfNotExists(cache_dir_))
+    {
+        PSN_LOG_WARN("Failed to create liberty cache directory {}",
+                     cache_dir_);
+        return false;
+    }
+    LibertyCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version      = kCacheVersion;
+    header.float_size   = sizeof(float);
+    header.size         = key.size;
+    header.mtime        = key.mtime;
+    header.hash         = key.hash;
+    header.content_hash = computeContentHash(path, key) ? key.content_hash : 0;
+    header.written      = nowNanoseconds();
+    header.image_size   = image.size();
+
+    std::string tmp_path = cache_path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(image.data(), image.size());
+        if (!out)
+        {
+            PSN_LOG_WARN("Failed to write liberty cache {}", cache_path);
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), cache_path.c_str()) != 0)
+    {
+        PSN_LOG_WARN("Failed to write liberty cache {}", cache_path);
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    PSN_LOG_DEBUG("Wrote liberty cache {}", cache_path);
+    return true;
+}
+} // namespace psn
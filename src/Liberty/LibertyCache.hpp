@@ -0,0 +1,160 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "OpenPhySyn/Database/Types.hpp"
+#include "OpenSTA/liberty/LibertyParser.hh"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sta
+{
+class Network;
+}
+
+namespace psn
+{
+// Identifies the liberty file a cache image was recorded from: hash is taken
+// over the resolved path and names the cache file, size and mtime tell
+// whether the file changed since. The content hash is only computed when the
+// metadata cannot tell.
+struct LibertyCacheKey
+{
+    uint64_t size;
+    int64_t  mtime;
+    uint64_t hash;
+    uint64_t content_hash;
+    bool     has_content_hash;
+};
+
+enum class LibertyImageStatus
+{
+    Loaded,
+    Missing,
+    Incompatible,
+    Stale,
+    Truncated
+};
+
+// Cache lookup result of a single liberty file.
+struct LibertyCacheEntry
+{
+    bool               has_key;
+    LibertyCacheKey    key;
+    std::string        cache_path;
+    LibertyImageStatus status;
+    std::string        image;
+    bool               outdated_header; // Loaded by content hash only
+};
+
+// Serializes the statements produced by the liberty parser into a compact
+// binary image.
+class LibertyImageWriter
+{
+public:
+    void beginGroup(sta::LibertyGroup* group);
+    void endGroup();
+    void attribute(sta::LibertyAttr* attr);
+    void variable(sta::LibertyVariable* variable);
+
+    const std::string& image() const;
+
+private:
+    void writeByte(uint8_t value);
+    void writeInt(int32_t value);
+    void writeFloat(float value);
+    void writeString(const char* value);
+    void writeValue(sta::LibertyAttrValue* value);
+    void writeValues(sta::LibertyAttrValueSeq* values);
+
+    std::string image_;
+};
+
+// Records the parser statements without building a library, used to
+// validate cache images against the text file.
+class LibertyStatementRecorder : public sta::LibertyGroupVisitor
+{
+public:
+    virtual void begin(sta::LibertyGroup* group) override;
+    virtual void end(sta::LibertyGroup* group) override;
+    virtual void visitAttr(sta::LibertyAttr* attr) override;
+    virtual void visitVariable(sta::LibertyVariable* variable) override;
+    virtual bool save(sta::LibertyGroup* group) override;
+    virtual bool save(sta::LibertyAttr* attr) override;
+    virtual bool save(sta::LibertyVariable* variable) override;
+
+    const std::string& image() const;
+
+private:
+    LibertyImageWriter writer_;
+};
+
+// Reads liberty files through a binary cache of the parsed statements. On a
+// miss the text file is parsed and the statements are recorded; on a hit
+// they are replayed into the OpenSTA liberty reader, skipping the tokenizer
+// and the parser.
+class LibertyCache
+{
+public:
+    LibertyCache(const std::string& cache_dir, bool validate = false);
+
+    sta::LibertyLibrary* read(const char* path, bool infer_latches,
+                              sta::Network* network);
+
+    // Loads the cache images of the files on worker threads, the entries are
+    // consumed by the following read calls.
+    void prefetch(const std::vector<std::string>& paths);
+
+    std::string cachePath(const char* path, const LibertyCacheKey& key) const;
+
+    static bool computeKey(const char* path, LibertyCacheKey& key);
+    static bool computeContentHash(const char* path, LibertyCacheKey& key);
+
+private:
+    LibertyCacheEntry lookup(const char* path) const;
+    static LibertyImageStatus readImage(const std::string& cache_path,
+                                        const char*        path,
+                                        LibertyCacheKey&   key,
+                                        std::string&       image,
+                                        bool&              outdated_header);
+    bool writeImage(const std::string& cache_path, const char* path,
+                    LibertyCacheKey& key, const std::string& image) const;
+
+    std::string cache_dir_;
+    bool        validate_;
+
+    std::unordered_map<std::string, LibertyCacheEntry> prefetched_;
+};
+} // namespace psn
@@ -29,12 +29,14 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 #include "LibertyReader.hpp"
+#include "LibertyCache.hpp"
 #include "OpenPhySyn/Sta/DatabaseStaNetwork.hpp"
 #include "OpenSTA/liberty/LibertyBuilder.hh"
 #include "OpenSTA/liberty/LibertyReader.hh"
 #include "OpenSTA/liberty/LibertyReaderPvt.hh"
 #include "PsnException/FileException.hpp"
 #include "PsnException/ParseLibertyException.hpp"
+#include "Utils/FileUtils.hpp"
 #include "sta/Error.hh"
 #include "sta/LeakagePower.hh"
 #include "sta/Liberty.hh"
@@ -46,19 +48,54 @@ LibertyReader::LibertyReader(sta::DatabaseSta* sta) : sta_(sta)
 {
 }
 
+void
+LibertyReader::setCache(const std::string& cache_dir, bool validate)
+{
+    cache_.reset(new LibertyCache(cache_dir, validate));
+}
+
+void
+LibertyReader::prefetch(const std::vector<std::string>& paths)
+{
+    if (cache_)
+    {
+        cache_->prefetch(paths);
+    }
+    else
+    {
+        FileUtils::readAhead(paths);
+    }
+}
+
 Liberty*
 LibertyReader::read(const char* path, bool infer_latches)
 {
+    if (cache_)
+    {
+        LibertyCache* cache = cache_.get();
+        sta_->setLibertyFileReader(
+            [cache](const char* filename, bool infer_latches,
+                    sta::Network* network) -> sta::LibertyLibrary* {
+                return cache->read(filename, infer_latches, network);
+            });
+    }
     try
     {
         Liberty* liberty = sta_->readLiberty(
             path, sta_->cmdCorner(), sta::MinMaxAll::all(), infer_latches);
+        sta_->setLibertyFileReader(nullptr);
         return liberty;
     }
     catch (sta::Exception& e)
     {
+        sta_->setLibertyFileReader(nullptr);
         throw ParseLibertyException(e.what());
     }
+    catch (...)
+    {
+        sta_->setLibertyFileReader(nullptr);
+        throw;
+    }
 }
 
 } // namespace psn
\ No newline at end of file
@@ -31,10 +31,15 @@
 
 #pragma once
 
+#include "LibertyCache.hpp"
 #include "OpenPhySyn/Database/Types.hpp"
 #include "OpenPhySyn/Sta/DatabaseSta.hpp"
 #include "OpenSTA/liberty/LibertyParser.hh"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace psn
 {
 class LibertyReader
@@ -43,7 +48,16 @@ public:
     LibertyReader(sta::DatabaseSta* sta);
     Liberty* read(const char* path, bool infer_latches = false);
 
+    // Reuse binary images of the parsed liberty files stored in cache_dir,
+    // validate compares the cached image with a fresh parse of the file.
+    void setCache(const std::string& cache_dir, bool validate = false);
+
+    // Starts loading the files ahead of the read calls that follow, only
+    // file access and cache lookups run concurrently.
+    void prefetch(const std::vector<std::string>& paths);
+
 private:
-    sta::DatabaseSta* sta_;
+    sta::DatabaseSta*             sta_;
+    std::unique_ptr<LibertyCache> cache_;
 };
 } // namespace psn
\ No newline at end of file
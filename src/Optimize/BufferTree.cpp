@@ -64,7 +64,8 @@ BufferTree::BufferTree(float cap, float req, float cost, Point location,
       buffer_count_(0),
       mode_(buffer_mode),
       library_mapping_node_(nullptr),
-      driver_location_(0, 0)
+      driver_location_(0, 0),
+      corner_count_(0)
 
 {
 }
@@ -91,7 +92,8 @@ BufferTree::BufferTree(Psn* psn_inst, std::shared_ptr<BufferTree> left,
       buffer_count_(left->bufferCount() + right->bufferCount()),
       mode_(left->mode()),
       library_mapping_node_(nullptr),
-      driver_location_(0, 0)
+      driver_location_(0, 0),
+      corner_count_(0)
 
 {
     required_or_slew_ =
@@ -99,6 +101,17 @@ BufferTree::BufferTree(Psn* psn_inst, std::shared_ptr<BufferTree> left,
                                    right->totalRequiredOrSlew()))
                        : std::min(left->totalRequiredOrSlew(),
                                   right->totalRequiredOrSlew()));
+    if (!isTimerless() && left->cornerCount() &&
+        left->cornerCount() == right->cornerCount())
+    {
+        float required[max_corners];
+        for (int i = 0; i < left->cornerCount(); i++)
+        {
+            required[i] = std::min(left->totalCornerRequired(i),
+                                   right->totalCornerRequired(i));
+        }
+        setCornerRequired(required, left->cornerCount());
+    }
     if (left->hasUpstreamBufferCell())
     {
         if (right->hasUpstreamBufferCell())
@@ -294,8 +307,21 @@ BufferTree::bufferFixedInputSlew(Psn* psn_inst, LibraryCell* buffer_cell)
 float
 BufferTree::bufferRequired(Psn* psn_inst, LibraryCell* buffer_cell) const
 {
-    return totalRequiredOrSlew() -
-           psn_inst->handler()->bufferDelay(buffer_cell, totalCapacitance());
+    if (!corner_count_)
+    {
+        return totalRequiredOrSlew() -
+               psn_inst->handler()->bufferDelay(buffer_cell,
+                                                totalCapacitance());
+    }
+    float worst_required = 1E+30F;
+    for (int i = 0; i < corner_count_; i++)
+    {
+        float delay = psn_inst->handler()->cornerBufferDelay(
+            buffer_cell, totalCapacitance(), i);
+        worst_required =
+            std::min(worst_required, totalCornerRequired(i) - delay);
+    }
+    return worst_required;
 }
 float
 BufferTree::bufferRequired(Psn* psn_inst) const
@@ -307,6 +333,126 @@ BufferTree::upstreamBufferRequired(Psn* psn_inst) const
 {
     return bufferRequired(psn_inst, upstream_buffer_cell_);
 }
+float
+BufferTree::driverRequired(Psn* psn_inst, LibraryTerm* driver_pin) const
+{
+    if (!corner_count_)
+    {
+        return totalRequiredOrSlew() -
+               psn_inst->handler()->gateDelay(driver_pin, totalCapacitance());
+    }
+    float worst_required = 1E+30F;
+    for (int i = 0; i < corner_count_; i++)
+    {
+        float delay = psn_inst->handler()->cornerGateDelay(
+            driver_pin, totalCapacitance(), i);
+        worst_required =
+            std::min(worst_required, totalCornerRequired(i) - delay);
+    }
+    return worst_required;
+}
+
+int
+BufferTree::cornerCount() const
+{
+    return corner_count_;
+}
+float
+BufferTree::cornerRequired(int corner_index) const
+{
+    return corner_required_[corner_index];
+}
+float
+BufferTree::totalCornerRequired(int corner_index) const
+{
+    return corner_required_[corner_index] - wire_delay_or_slew_;
+}
+void
+BufferTree::setCornerRequired(const float* required, int corner_count)
+{
+    corner_count_ = std::min(corner_count, max_corners);
+    if (!corner_count_)
+    {
+        return;
+    }
+    required_or_slew_ = required[0];
+    for (int i = 0; i < corner_count_; i++)
+    {
+        corner_required_[i] = required[i];
+        required_or_slew_   = std::min(required_or_slew_, required[i]);
+    }
+}
+int
+BufferTree::driverArrivalOffsets(Psn* psn_inst, InstanceTerm* driver_pin,
+                                 float* arrival_offsets)
+{
+    DatabaseHandler& handler = *(psn_inst->handler());
+    // Past max_corners the candidates fall back to the default corner.
+    int corner_count = handler.cornerCount();
+    if (corner_count < 2 || corner_count > max_corners)
+    {
+        return 0;
+    }
+    // The driver inputs arrive at a different time in each corner. Each
+    // corner is shifted by its arrival relative to the latest one, so the
+    // worst corner of a tree is the one with the least slack rather than
+    // the earliest required time.
+    float latest_arrival = -1E+30F;
+    for (int i = 0; i < corner_count; i++)
+    {
+        float arrival = 0;
+        if (handler.isTopLevel(driver_pin))
+        {
+            arrival = handler.cornerArrival(driver_pin, i);
+        }
+        else
+        {
+            handler.forEachInputPin(
+                handler.instance(driver_pin), [&](InstanceTerm* pin) {
+                    arrival = std::max(arrival, handler.cornerArrival(pin, i));
+                });
+        }
+        arrival_offsets[i] = arrival;
+        latest_arrival     = std::max(latest_arrival, arrival);
+    }
+    for (int i = 0; i < corner_count; i++)
+    {
+        arrival_offsets[i] -= latest_arrival;
+    }
+    return corner_count;
+}
+void
+BufferTree::loadCornerRequired(Psn* psn_inst, InstanceTerm* load_pin,
+                               const float* arrival_offsets, int corner_count)
+{
+    if (!corner_count)
+    {
+        return;
+    }
+    DatabaseHandler& handler = *(psn_inst->handler());
+    float            required[max_corners];
+    for (int i = 0; i < corner_count; i++)
+    {
+        required[i] = handler.cornerRequired(load_pin, i) - arrival_offsets[i];
+    }
+    setCornerRequired(required, corner_count);
+}
+void
+BufferTree::updateCornerRequired(Psn* psn_inst)
+{
+    if (!buffer_cell_ || !left_ || !left_->cornerCount())
+    {
+        return;
+    }
+    float required[max_corners];
+    for (int i = 0; i < left_->cornerCount(); i++)
+    {
+        required[i] = left_->totalCornerRequired(i) -
+                      psn_inst->handler()->cornerBufferDelay(
+                          buffer_cell_, left_->totalCapacitance(), i);
+    }
+    setCornerRequired(required, left_->cornerCount());
+}
 
 bool
 BufferTree::hasDownstreamSlewViolation(Psn* psn_inst, float slew_limit,
@@ -636,6 +782,7 @@ BufferSolution::addLeafTrees(Psn* psn_inst, InstanceTerm*, Point pt,
                 pt, nullptr, nullptr, buff);
             buffer_opt->setBufferCount(optimal_tree->bufferCount() + 1);
             buffer_opt->setLeft(optimal_tree);
+            buffer_opt->updateCornerRequired(psn_inst);
             buffer_trees_.push_back(buffer_opt);
         }
         for (auto& inv : inverter_lib)
@@ -662,6 +809,7 @@ BufferSolution::addLeafTrees(Psn* psn_inst, InstanceTerm*, Point pt,
             buffer_opt->setBufferCount(optimal_tree->bufferCount() + 1);
 
             buffer_opt->setLeft(optimal_tree);
+            buffer_opt->updateCornerRequired(psn_inst);
             buffer_trees_.push_back(buffer_opt);
         }
     }
@@ -776,6 +924,7 @@ BufferSolution::addLeafTreesWithResynthesis(
             nullptr, nullptr, buff);
         buffer_opt->setBufferCount(optimal_tree->bufferCount() + 1);
         buffer_opt->setLeft(optimal_tree);
+        buffer_opt->updateCornerRequired(psn_inst);
         buffer_trees_.push_back(buffer_opt);
     }
     for (auto& inv : inverter_lib)
@@ -805,6 +954,7 @@ BufferSolution::addLeafTreesWithResynthesis(
             buffer_opt->setBufferCount(optimal_tree->bufferCount() + 1);
 
             buffer_opt->setLeft(optimal_tree);
+            buffer_opt->updateCornerRequired(psn_inst);
             buffer_trees_.push_back(buffer_opt);
         }
     }
@@ -841,6 +991,7 @@ BufferSolution::addLeafTreesWithResynthesis(
                         nullptr, buff);
                     buffer_opt->setBufferCount(optimal_tree->bufferCount() + 1);
                     buffer_opt->setLeft(optimal_tree);
+                    buffer_opt->updateCornerRequired(psn_inst);
                     buffer_opt->setLibraryMappingNode(term);
                     buffer_trees_.push_back(buffer_opt);
                 }
@@ -877,6 +1028,7 @@ BufferSolution::addLeafTreesWithResynthesis(
                                                    1);
 
                         buffer_opt->setLeft(optimal_tree);
+                        buffer_opt->updateCornerRequired(psn_inst);
                         buffer_opt->setLibraryMappingNode(term);
                         buffer_trees_.push_back(buffer_opt);
                     }
@@ -943,9 +1095,7 @@ BufferSolution::optimalDriverTreeWithResize(
                 psn_inst->handler()->bufferChainDelayPenalty(max_cap) +
                 area_penalty * psn_inst->handler()->area(drv_type);
 
-            float delay = psn_inst->handler()->gateDelay(
-                drvr_pin, tree->totalCapacitance());
-            float slack = tree->totalRequiredOrSlew() - delay - penalty;
+            float slack = tree->driverRequired(psn_inst, drvr_pin) - penalty;
 
             if (slack > max_slack)
             {
@@ -967,18 +1117,15 @@ BufferSolution::optimalDriverTreeWithResynthesis(Psn*          psn_inst,
     {
         return nullptr;
     }
-    DatabaseHandler& handler = *(psn_inst->handler());
+    DatabaseHandler& handler     = *(psn_inst->handler());
+    auto             driver_port = handler.libraryPin(driver_pin);
 
     auto first_tree = buffer_trees_[0];
     std::sort(buffer_trees_.begin(), buffer_trees_.end(),
               [&](const std::shared_ptr<BufferTree>& a,
                   const std::shared_ptr<BufferTree>& b) -> bool {
-                  float a_delay = psn_inst->handler()->gateDelay(
-                      driver_pin, a->totalCapacitance());
-                  float a_slack = a->totalRequiredOrSlew() - a_delay;
-                  float b_delay = psn_inst->handler()->gateDelay(
-                      driver_pin, b->totalCapacitance());
-                  float b_slack = b->totalRequiredOrSlew() - b_delay;
+                  float a_slack = a->driverRequired(psn_inst, driver_port);
+                  float b_slack = b->driverRequired(psn_inst, driver_port);
                   return a_slack > b_slack ||
                          (isEqual(a_slack, b_slack, 1E-6F) &&
                           a->cost() < b->cost());
@@ -1039,9 +1186,7 @@ BufferSolution::optimalDriverTreeWithResynthesis(Psn*          psn_inst,
                 if (handler.isSingleOutputCombinational(d_type))
                 {
                     auto  d_pin = handler.libraryOutputPins(d_type)[0];
-                    float delay =
-                        handler.gateDelay(d_pin, tree->totalCapacitance());
-                    float slack = tree->totalRequiredOrSlew() - delay;
+                    float slack = tree->driverRequired(psn_inst, d_pin);
                     float cost =
                         tree->cost() + handler.area(d_type) - original_cost;
                     if (isGreater(slack, max_slack) ||
@@ -1063,8 +1208,8 @@ BufferSolution::optimalDriverTreeWithResynthesis(Psn*          psn_inst,
         {
             continue;
         }
-        float delay = handler.gateDelay(driver_pin, tree->totalCapacitance());
-        float slack = tree->totalRequiredOrSlew() - delay - orig_penalty;
+        float slack =
+            tree->driverRequired(psn_inst, driver_port) - orig_penalty;
 
         if (isGreater(slack, max_slack))
         {
@@ -1117,17 +1262,14 @@ BufferSolution::optimalDriverTree(Psn* psn_inst, InstanceTerm* driver_pin,
     {
         return nullptr;
     }
+    auto driver_port = psn_inst->handler()->libraryPin(driver_pin);
 
     auto first_tree = buffer_trees_[0];
     std::sort(buffer_trees_.begin(), buffer_trees_.end(),
               [&](const std::shared_ptr<BufferTree>& a,
                   const std::shared_ptr<BufferTree>& b) -> bool {
-                  float a_delay = psn_inst->handler()->gateDelay(
-                      driver_pin, a->totalCapacitance());
-                  float a_slack = a->totalRequiredOrSlew() - a_delay;
-                  float b_delay = psn_inst->handler()->gateDelay(
-                      driver_pin, b->totalCapacitance());
-                  float b_slack = b->totalRequiredOrSlew() - b_delay;
+                  float a_slack = a->driverRequired(psn_inst, driver_port);
+                  float b_slack = b->driverRequired(psn_inst, driver_port);
                   return a_slack > b_slack ||
                          (isEqual(a_slack, b_slack, 1E-6F) &&
                           a->cost() < b->cost());
@@ -1145,9 +1287,7 @@ BufferSolution::optimalDriverTree(Psn* psn_inst, InstanceTerm* driver_pin,
             }
             continue;
         }
-        float delay = psn_inst->handler()->gateDelay(driver_pin,
-                                                     tree->totalCapacitance());
-        float slack = tree->totalRequiredOrSlew() - delay;
+        float slack = tree->driverRequired(psn_inst, driver_port);
 
         if (isGreater(slack, max_slack))
         {
@@ -1257,9 +1397,8 @@ BufferSolution::optimalCostTree(Psn* psn_inst, InstanceTerm* driver_pin,
         if (tree->checkLimits(psn_inst, handler.libraryPin(driver_pin),
                               slew_limit, cap_limit))
         {
-            float delay =
-                handler.gateDelay(driver_pin, tree->totalCapacitance());
-            float slack = tree->totalRequiredOrSlew() - delay;
+            float slack =
+                tree->driverRequired(psn_inst, handler.libraryPin(driver_pin));
             if (second_best == nullptr)
             {
                 second_best = tree;
@@ -1464,6 +1603,20 @@ BufferSolution::bottomUp(Psn* psn_inst, InstanceTerm* driver_pin,
                          SteinerPoint pt, SteinerPoint prev,
                          std::shared_ptr<SteinerTree>          st_tree,
                          std::unique_ptr<OptimizationOptions>& options)
+{
+    float arrival_offsets[BufferTree::max_corners];
+    int   corner_count =
+        BufferTree::driverArrivalOffsets(psn_inst, driver_pin, arrival_offsets);
+    return bottomUp(psn_inst, driver_pin, pt, prev, st_tree, options,
+                    arrival_offsets, corner_count);
+}
+
+std::shared_ptr<BufferSolution>
+BufferSolution::bottomUp(Psn* psn_inst, InstanceTerm* driver_pin,
+                         SteinerPoint pt, SteinerPoint prev,
+                         std::shared_ptr<SteinerTree>          st_tree,
+                         std::unique_ptr<OptimizationOptions>& options,
+                         const float* arrival_offsets, int corner_count)
 {
     DatabaseHandler& handler = *(psn_inst->handler());
     if (pt != SteinerNull)
@@ -1489,6 +1642,8 @@ BufferSolution::bottomUp(Psn* psn_inst, InstanceTerm* driver_pin,
                 std::make_shared<BufferTree>(cap, req, 0, location,
                                              handler.libraryPin(driver_pin),
                                              pt_pin);
+            base_buffer_tree->loadCornerRequired(psn_inst, pt_pin,
+                                                 arrival_offsets, corner_count);
             std::shared_ptr<BufferSolution> buff_sol =
                 std::make_shared<BufferSolution>();
             buff_sol->addTree(base_buffer_tree);
@@ -1506,11 +1661,13 @@ BufferSolution::bottomUp(Psn* psn_inst, InstanceTerm* driver_pin,
             PSN_LOG_TRACE("({}, {}) bottomUp ---> left", location.getX(),
                           location.getY());
             auto left = bottomUp(psn_inst, driver_pin, st_tree->left(pt), pt,
-                                 st_tree, options);
+                                 st_tree, options, arrival_offsets,
+                                 corner_count);
             PSN_LOG_TRACE("({}, {}) bottomUp ---> right", location.getX(),
                           location.getY());
             auto right = bottomUp(psn_inst, driver_pin, st_tree->right(pt), pt,
-                                  st_tree, options);
+                                  st_tree, options, arrival_offsets,
+                                  corner_count);
 
             PSN_LOG_TRACE("({}, {}) bottomUp merging", location.getX(),
                           location.getY());
@@ -1536,6 +1693,22 @@ BufferSolution::bottomUpWithResynthesis(
     std::shared_ptr<SteinerTree>                          st_tree,
     std::unique_ptr<OptimizationOptions>&                 options,
     std::vector<std::shared_ptr<LibraryCellMappingNode>>& mapping_terminals)
+{
+    float arrival_offsets[BufferTree::max_corners];
+    int   corner_count =
+        BufferTree::driverArrivalOffsets(psn_inst, driver_pin, arrival_offsets);
+    return bottomUpWithResynthesis(psn_inst, driver_pin, pt, prev, st_tree,
+                                   options, mapping_terminals, arrival_offsets,
+                                   corner_count);
+}
+
+std::shared_ptr<BufferSolution>
+BufferSolution::bottomUpWithResynthesis(
+    Psn* psn_inst, InstanceTerm* driver_pin, SteinerPoint pt, SteinerPoint prev,
+    std::shared_ptr<SteinerTree>                          st_tree,
+    std::unique_ptr<OptimizationOptions>&                 options,
+    std::vector<std::shared_ptr<LibraryCellMappingNode>>& mapping_terminals,
+    const float* arrival_offsets, int corner_count)
 {
     DatabaseHandler& handler = *(psn_inst->handler());
     if (pt != SteinerNull)
@@ -1561,6 +1734,8 @@ BufferSolution::bottomUpWithResynthesis(
                 std::make_shared<BufferTree>(cap, req, 0, location,
                                              handler.libraryPin(driver_pin),
                                              pt_pin);
+            base_buffer_tree->loadCornerRequired(psn_inst, pt_pin,
+                                                 arrival_offsets, corner_count);
             std::shared_ptr<BufferSolution> buff_sol =
                 std::make_shared<BufferSolution>();
             buff_sol->addTree(base_buffer_tree);
@@ -1579,11 +1754,13 @@ BufferSolution::bottomUpWithResynthesis(
             PSN_LOG_TRACE("({}, {}) bottomUp ---> left", location.getX(),
                           location.getY());
             auto left = bottomUp(psn_inst, driver_pin, st_tree->left(pt), pt,
-                                 st_tree, options);
+                                 st_tree, options, arrival_offsets,
+                                 corner_count);
             PSN_LOG_TRACE("({}, {}) bottomUp ---> right", location.getX(),
                           location.getY());
             auto right = bottomUp(psn_inst, driver_pin, st_tree->right(pt), pt,
-                                  st_tree, options);
+                                  st_tree, options, arrival_offsets,
+                                  corner_count);
 
             PSN_LOG_TRACE("({}, {}) bottomUp merging", location.getX(),
                           location.getY());
@@ -1606,8 +1783,8 @@ BufferSolution::bottomUpWithResynthesis(
 
 void
 BufferSolution::topDown(Psn* psn_inst, InstanceTerm* pin,
-                        std::shared_ptr<BufferTree> tree, float& area,
-                        int& net_index, int& buff_index,
+                        std::shared_ptr<BufferTree> tree, int& net_index,
+                        int& buff_index,
                         std::unordered_set<Instance*>& added_buffers,
                         std::unordered_set<Net*>&      affected_nets)
 {
@@ -1620,13 +1797,13 @@ BufferSolution::topDown(Psn* psn_inst, InstanceTerm* pin,
     {
         PSN_LOG_ERROR("No net for {}", psn_inst->handler()->name(pin));
     }
-    topDown(psn_inst, net, tree, area, net_index, buff_index, added_buffers,
+    topDown(psn_inst, net, tree, net_index, buff_index, added_buffers,
             affected_nets);
 }
 void
 BufferSolution::topDown(Psn* psn_inst, Net* net,
-                        std::shared_ptr<BufferTree> tree, float& area,
-                        int& net_index, int& buff_index,
+                        std::shared_ptr<BufferTree> tree, int& net_index,
+                        int& buff_index,
                         std::unordered_set<Instance*>& added_buffers,
                         std::unordered_set<Net*>&      affected_nets)
 {
@@ -1682,18 +1859,17 @@ BufferSolution::topDown(Psn* psn_inst, Net* net,
                                          buffer_net_name, tree->location());
         affected_nets.insert(net);
         affected_nets.insert(buf_net);
-        area += handler.area(tree->bufferCell());
         added_buffers.insert(handler.instance(handler.faninPin(buf_net)));
-        topDown(psn_inst, buf_net, tree->left(), area, net_index, buff_index,
+        topDown(psn_inst, buf_net, tree->left(), net_index, buff_index,
                 added_buffers, affected_nets);
     }
     else if (tree->isBranched())
     {
         PSN_LOG_DEBUG("{}: Buffering left..", handler.name(net));
-        topDown(psn_inst, net, tree->left(), area, net_index, buff_index,
+        topDown(psn_inst, net, tree->left(), net_index, buff_index,
                 added_buffers, affected_nets);
         PSN_LOG_DEBUG("{}: Buffering right..", handler.name(net));
-        topDown(psn_inst, net, tree->right(), area, net_index, buff_index,
+        topDown(psn_inst, net, tree->right(), net_index, buff_index,
                 added_buffers, affected_nets);
     }
 }
@@ -0,0 +1,422 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "OpenPhySyn/Optimize/RowLegalizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "OpenPhySyn/Database/DatabaseHandler.hpp"
+#include "OpenPhySyn/PsnLogger/PsnLogger.hpp"
+#include "OpenPhySyn/Sta/DatabaseStaNetwork.hpp"
+#include "opendb/db.h"
+
+namespace psn
+{
+RowLegalizer::RowLegalizer(DatabaseHandler* handler)
+    : handler_(handler), rows_valid_(false), max_row_height_(0)
+{
+}
+
+void
+RowLegalizer::add(Instance* inst)
+{
+    if (pending_.insert(inst).second)
+    {
+        pending_order_.push_back(inst);
+    }
+    release(inst);
+}
+
+void
+RowLegalizer::remove(Instance* inst)
+{
+    pending_.erase(inst);
+    release(inst);
+}
+
+void
+RowLegalizer::reset()
+{
+    rows_.clear();
+    rows_valid_     = false;
+    max_row_height_ = 0;
+    pending_order_.clear();
+    pending_.clear();
+    occupancy_.clear();
+}
+
+int
+RowLegalizer::pendingCount() const
+{
+    return pending_.size();
+}
+
+void
+RowLegalizer::buildRows()
+{
+    rows_.clear();
+    occupancy_.clear();
+    max_row_height_ = 0;
+    Block* block    = handler_->top();
+    if (!block)
+    {
+        return;
+    }
+    for (odb::dbRow* db_row : block->getRows())
+    {
+        if (db_row->getDirection() != odb::dbRowDir::HORIZONTAL)
+        {
+            continue;
+        }
+        odb::dbSite* site = db_row->getSite();
+        int          x, y;
+        db_row->getOrigin(x, y);
+        Row row;
+        row.row       = db_row;
+        row.pitch     = db_row->getSpacing() > 0 ? db_row->getSpacing()
+                                                 : (int)site->getWidth();
+        row.x_min     = x;
+        row.x_max     = x + (db_row->getSiteCount() - 1) * row.pitch +
+                    site->getWidth();
+        row.y         = y;
+        row.height    = site->getHeight();
+        row.max_width = 0;
+        max_row_height_ = std::max(max_row_height_, row.height);
+        rows_.push_back(row);
+    }
+    std::sort(rows_.begin(), rows_.end(), [](const Row& a, const Row& b) {
+        return a.y < b.y || (a.y == b.y && a.x_min < b.x_min);
+    });
+
+    for (odb::dbInst* dinst : block->getInsts())
+    {
+        if (!dinst->getPlacementStatus().isPlaced())
+        {
+            continue;
+        }
+        Instance* inst = handler_->network()->dbToSta(dinst);
+        if (!pending_.count(inst))
+        {
+            occupy(inst, dinst);
+        }
+    }
+    rows_valid_ = true;
+}
+
+void
+RowLegalizer::occupy(Instance* inst, odb::dbInst* dinst)
+{
+    odb::dbBox* box   = dinst->getBBox();
+    int         x_min = box->xMin();
+    int         x_max = box->xMax();
+    int         y_min = box->yMin();
+    int         y_max = box->yMax();
+
+    auto& occupancy = occupancy_[inst];
+    auto  itr       = std::lower_bound(
+        rows_.begin(), rows_.end(), y_min - max_row_height_,
+        [](const Row& row, int y) { return row.y <= y; });
+    for (; itr != rows_.end() && itr->y < y_max; itr++)
+    {
+        Row& row = *itr;
+        if (row.y + row.height <= y_min || row.x_max <= x_min ||
+            row.x_min >= x_max)
+        {
+            continue;
+        }
+        int begin = std::max(x_min, row.x_min);
+        int end   = std::min(x_max, row.x_max);
+        row.occupied.insert(std::make_pair(begin, end));
+        row.max_width = std::max(row.max_width, end - begin);
+        occupancy.push_back({(int)(itr - rows_.begin()), begin, end});
+    }
+}
+
+void
+RowLegalizer::release(Instance* inst)
+{
+    auto itr = occupancy_.find(inst);
+    if (itr == occupancy_.end())
+    {
+        return;
+    }
+    for (auto& occ : itr->second)
+    {
+        auto& occupied = rows_[occ.row].occupied;
+        auto  range    = occupied.equal_range(occ.begin);
+        for (auto entry = range.first; entry != range.second; entry++)
+        {
+            if (entry->second == occ.end)
+            {
+                occupied.erase(entry);
+                break;
+            }
+        }
+    }
+    occupancy_.erase(itr);
+}
+
+bool
+RowLegalizer::overlaps(const Row& row, int x, int width, int& min_begin,
+                       int& max_end) const
+{
+    bool found = false;
+    for (auto itr = row.occupied.lower_bound(x - row.max_width);
+         itr != row.occupied.end() && itr->first < x + width; itr++)
+    {
+        if (itr->second <= x)
+        {
+            continue;
+        }
+        min_begin = found ? std::min(min_begin, itr->first) : itr->first;
+        max_end   = found ? std::max(max_end, itr->second) : itr->second;
+        found     = true;
+    }
+    return found;
+}
+
+bool
+RowLegalizer::rowSpan(int index, int height, std::vector<int>& span) const
+{
+    const Row& bottom = rows_[index];
+    int        top    = bottom.y + bottom.height;
+    span.assign(1, index);
+    for (int i = index + 1; i < (int)rows_.size() && top < bottom.y + height;
+         i++)
+    {
+        const Row& row = rows_[i];
+        if (row.y > top)
+        {
+            break;
+        }
+        if (row.y == top && row.x_min < bottom.x_max &&
+            row.x_max > bottom.x_min)
+        {
+            span.push_back(i);
+            top += row.height;
+        }
+    }
+    return top >= bottom.y + height;
+}
+
+bool
+RowLegalizer::overlaps(const std::vector<int>& span, int x, int width,
+                       int& min_begin, int& max_end) const
+{
+    bool found = false;
+    for (auto index : span)
+    {
+        int row_begin, row_end;
+        if (overlaps(rows_[index], x, width, row_begin, row_end))
+        {
+            min_begin = found ? std::min(min_begin, row_begin) : row_begin;
+            max_end   = found ? std::max(max_end, row_end) : row_end;
+            found     = true;
+        }
+    }
+    return found;
+}
+
+bool
+RowLegalizer::findSite(const std::vector<int>& span, int width, int target_x,
+                       int& x) const
+{
+    // A cell spanning several rows needs the same sites free in all of them.
+    const Row& first = rows_[span[0]];
+    int        x_min = first.x_min;
+    int        x_max = first.x_max;
+    int        pitch = first.pitch;
+    for (auto index : span)
+    {
+        x_min = std::max(x_min, rows_[index].x_min);
+        x_max = std::min(x_max, rows_[index].x_max);
+    }
+    if (width > x_max - x_min)
+    {
+        return false;
+    }
+    int last  = x_min + ((x_max - width - x_min) / pitch) * pitch;
+    int start = x_min +
+                (int)std::lround((target_x - x_min) * 1.0 / pitch) * pitch;
+    start     = std::min(std::max(start, x_min), last);
+
+    bool found     = false;
+    int  best_dist = std::numeric_limits<int>::max();
+    int  min_begin = 0, max_end = 0;
+
+    // Nearest free position to the right, then to the left.
+    for (int c = start; c <= last;)
+    {
+        if (!overlaps(span, c, width, min_begin, max_end))
+        {
+            found     = true;
+            x         = c;
+            best_dist = std::abs(c - target_x);
+            break;
+        }
+        c = x_min + ((max_end - x_min + pitch - 1) / pitch) * pitch;
+    }
+    for (int c = start; c >= x_min && std::abs(c - target_x) < best_dist;)
+    {
+        if (!overlaps(span, c, width, min_begin, max_end))
+        {
+            found = true;
+            x     = c;
+            break;
+        }
+        int next = min_begin - width;
+        if (next < x_min)
+        {
+            break;
+        }
+        c = x_min + ((next - x_min) / pitch) * pitch;
+    }
+    return found;
+}
+
+bool
+RowLegalizer::place(Instance* inst, int max_displacement)
+{
+    odb::dbInst* dinst = handler_->network()->staToDb(inst);
+    if (!dinst->getPlacementStatus().isPlaced())
+    {
+        return true;
+    }
+    if (dinst->getPlacementStatus().isFixed())
+    {
+        occupy(inst, dinst);
+        return true;
+    }
+    odb::dbMaster* master = dinst->getMaster();
+    int            width  = master->getWidth();
+    int            height = master->getHeight();
+    int            target_x, target_y;
+    dinst->getLocation(target_x, target_y);
+
+    // Visit the rows in order of vertical distance from the target until the
+    // distance alone exceeds the best displacement found so far. A row is
+    // the bottom of the stack of abutting rows covering the cell height.
+    int  up   = std::lower_bound(rows_.begin(), rows_.end(), target_y,
+                              [](const Row& row, int y) { return row.y < y; }) -
+             rows_.begin();
+    int  down      = up - 1;
+    int  rows      = rows_.size();
+    bool found     = false;
+    int  best_cost = std::numeric_limits<int>::max();
+    int  best_row  = -1;
+    int  best_x    = 0;
+    std::vector<int> span;
+    while (up < rows || down >= 0)
+    {
+        int index;
+        if (down < 0 || (up < rows && std::abs(rows_[up].y - target_y) <=
+                                          std::abs(rows_[down].y - target_y)))
+        {
+            index = up++;
+        }
+        else
+        {
+            index = down--;
+        }
+        const Row& row = rows_[index];
+        int        dy  = std::abs(row.y - target_y);
+        if (dy >= best_cost ||
+            (max_displacement > 0 && dy > max_displacement * row.height))
+        {
+            break;
+        }
+        if (!rowSpan(index, height, span))
+        {
+            continue;
+        }
+        int x;
+        if (findSite(span, width, target_x, x))
+        {
+            int cost = std::abs(x - target_x) + dy;
+            if (cost < best_cost)
+            {
+                found     = true;
+                best_cost = cost;
+                best_row  = index;
+                best_x    = x;
+            }
+        }
+    }
+    if (!found)
+    {
+        PSN_LOG_DEBUG("Could not find a legal site for {}",
+                      handler_->name(inst));
+        occupy(inst, dinst);
+        return false;
+    }
+    // Moved through the handler so that the move is recorded in the ECO.
+    auto orient = rows_[best_row].row->getOrient();
+    if (best_x != target_x || rows_[best_row].y != target_y ||
+        dinst->getOrient() != orient)
+    {
+        dinst->setOrient(orient);
+        handler_->moveInstance(inst, Point(best_x, rows_[best_row].y));
+    }
+    occupy(inst, dinst);
+    return true;
+}
+
+bool
+RowLegalizer::legalize(int max_displacement)
+{
+    if (!rows_valid_)
+    {
+        buildRows();
+    }
+    bool                   legal = true;
+    int                    moved = 0;
+    std::vector<Instance*> order;
+    order.swap(pending_order_);
+    for (auto inst : order)
+    {
+        if (!pending_.erase(inst))
+        {
+            continue;
+        }
+        if (place(inst, max_displacement))
+        {
+            moved++;
+        }
+        else
+        {
+            legal = false;
+        }
+    }
+    PSN_LOG_DEBUG("Legalized {} instances", moved);
+    return legal;
+}
+} // namespace psn
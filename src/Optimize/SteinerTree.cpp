@@ -37,9 +37,15 @@ namespace psn
 {
 std::unique_ptr<SteinerTree>
 SteinerTree::create(Net* net, Psn* psn_inst, int flute_accuracy)
+{
+    return create(net, psn_inst->handler()->connectedPins(net), psn_inst,
+                  flute_accuracy);
+}
+std::unique_ptr<SteinerTree>
+SteinerTree::create(Net* net, const std::vector<InstanceTerm*>& pins,
+                    Psn* psn_inst, int flute_accuracy)
 {
     DatabaseHandler& handler = *(psn_inst->handler());
-    auto             pins    = handler.connectedPins(net);
 
     std::unique_ptr<SteinerTree> tree(nullptr);
     unsigned int                 pin_count = pins.size();
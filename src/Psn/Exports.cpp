@@ -30,6 +30,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include "Exports.hpp"
+#include <limits>
 #include <memory>
 #include "OpenPhySyn/Psn/Psn.hpp"
 #include "OpenPhySyn/Utils/PsnGlobal.hpp"
@@ -70,11 +71,54 @@ import_liberty(const char* lib_path)
     return Psn::instance().readLib(lib_path);
 }
 int
+import_lib(const char* lib_path, const char* cache_dir, bool validate_cache)
+{
+    return import_liberty(lib_path, cache_dir, validate_cache);
+}
+int
+import_liberty(const char* lib_path, const char* cache_dir,
+               bool validate_cache)
+{
+    return Psn::instance().readLib(lib_path, cache_dir, validate_cache);
+}
+int
+import_libs(std::vector<std::string> lib_paths)
+{
+    return Psn::instance().readLibs(lib_paths);
+}
+int
+import_libs(std::vector<std::string> lib_paths, const char* cache_dir,
+            bool validate_cache)
+{
+    return Psn::instance().readLibs(lib_paths, cache_dir, validate_cache);
+}
+int
+import_lefs_internal(std::vector<std::string> lef_paths, bool import_library,
+                     bool import_tech)
+{
+    return Psn::instance().readLefs(lef_paths, import_library, import_tech);
+}
+int
 export_def(const char* lib_path)
 {
     return Psn::instance().writeDef(lib_path);
 }
 int
+import_eco(const char* eco_path)
+{
+    return Psn::instance().readEco(eco_path);
+}
+int
+export_eco(const char* eco_path)
+{
+    return Psn::instance().writeEco(eco_path);
+}
+int
+export_timing(const char* snapshot_path)
+{
+    return Psn::instance().writeTimingSnapshot(snapshot_path);
+}
+int
 import_db(const char* db_path)
 {
     return Psn::instance().readDatabase(db_path);
@@ -85,6 +129,21 @@ export_db(const char* db_path)
     return Psn::instance().writeDatabase(db_path);
 }
 int
+export_db(const char* db_path, bool async, bool compress)
+{
+    return Psn::instance().writeDatabase(db_path, async, compress);
+}
+int
+wait_export_db()
+{
+    return Psn::instance().waitDatabaseWrite();
+}
+std::string
+export_db_status()
+{
+    return Psn::instance().databaseWriteStatus();
+}
+int
 print_liberty_cells()
 {
     Liberty* liberty = Psn::instance().liberty();
@@ -142,6 +201,11 @@ core_area()
 {
     return Psn::instance().handler()->coreArea();
 }
+float
+utilization()
+{
+    return Psn::instance().handler()->utilization();
+}
 
 void
 set_dont_use(std::vector<std::string> cell_names)
@@ -191,6 +255,78 @@ capacitance_violations()
     return names;
 }
 
+// Missing pins are logged and kept as nullptr so the results stay aligned
+// with the requested names; their entries are reported as NaN.
+static std::vector<InstanceTerm*>
+find_pins(std::vector<std::string>& pin_names)
+{
+    auto                       handler = Psn::instance().handler();
+    std::vector<InstanceTerm*> terms;
+    terms.reserve(pin_names.size());
+    for (auto& pin_name : pin_names)
+    {
+        auto term = handler->pin(pin_name.c_str());
+        if (!term)
+        {
+            PSN_LOG_ERROR("Could not find pin {}.", pin_name);
+        }
+        terms.push_back(term);
+    }
+    return terms;
+}
+std::vector<float>
+pin_slacks(std::vector<std::string> pin_names)
+{
+    if (!Psn::instance().hasDesign())
+    {
+        PSN_LOG_ERROR("Could not find any loaded design.");
+        return std::vector<float>();
+    }
+    auto terms  = find_pins(pin_names);
+    auto slacks = Psn::instance().handler()->worstSlacks(terms);
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        if (!terms[i])
+        {
+            slacks[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+    return slacks;
+}
+std::vector<float>
+pin_timings(std::vector<std::string> pin_names)
+{
+    // Flattened as [slack, slew, load, slew_limit, capacitance_limit,
+    // violation] per pin so the whole batch crosses the Tcl boundary in a
+    // single list.
+    std::vector<float> result;
+    if (!Psn::instance().hasDesign())
+    {
+        PSN_LOG_ERROR("Could not find any loaded design.");
+        return result;
+    }
+    auto       terms = find_pins(pin_names);
+    PinTimings timings;
+    Psn::instance().handler()->pinTimings(terms, timings);
+    result.reserve(terms.size() * 6);
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        if (!terms[i])
+        {
+            result.insert(result.end(), 6,
+                          std::numeric_limits<float>::quiet_NaN());
+            continue;
+        }
+        result.push_back(timings.slacks[i]);
+        result.push_back(timings.slews[i]);
+        result.push_back(timings.loads[i]);
+        result.push_back(timings.slew_limits[i]);
+        result.push_back(timings.capacitance_limits[i]);
+        result.push_back(static_cast<float>(timings.violations[i]));
+    }
+    return result;
+}
+
 std::vector<std::string>
 cluster_buffer_names(float cluster_threshold, bool find_superior)
 {
@@ -50,9 +50,23 @@ int   import_lef_sc(const char* lef_path);
 int   import_lef_tech_sc(const char* lef_path);
 int   import_lib(const char* lib_path); // Alias for import_liberty
 int   import_liberty(const char* lib_path);
+int   import_lib(const char* lib_path, const char* cache_dir,
+                 bool validate_cache = false);
+int   import_liberty(const char* lib_path, const char* cache_dir,
+                     bool validate_cache = false);
+int   import_libs(std::vector<std::string> lib_paths);
+int   import_libs(std::vector<std::string> lib_paths, const char* cache_dir,
+                  bool validate_cache = false);
+int   import_lefs_internal(std::vector<std::string> lef_paths,
+                           bool import_library, bool import_tech);
 int   export_def(const char* def_path);
 int   import_db(const char* db_path);
+int   import_eco(const char* eco_path);
+int   export_eco(const char* eco_path);
+int   export_timing(const char* snapshot_path);
 int   export_db(const char* db_path);
+int   export_db(const char* db_path, bool async, bool compress = false);
+int   wait_export_db();
 int   print_liberty_cells();
 bool  has_transform(const char* transform_name);
 int   set_wire_rc(float res_per_micron, float cap_per_micron);
@@ -60,6 +74,7 @@ int   set_wire_rc(const char* layer_name);
 int   set_max_area(float area);
 float max_area();
 float core_area();
+float utilization();
 int   link(const char* top_module);
 int   link_design(const char* top_module);
 int   set_log(const char* level);
@@ -68,8 +83,11 @@ int   set_log_pattern(const char* pattern);
 void  set_dont_use(std::vector<std::string> cell_names);
 bool  has_design();
 bool  has_liberty();
+std::string              export_db_status();
 std::vector<std::string> capacitance_violations();
 std::vector<std::string> transition_violations();
+std::vector<float>       pin_slacks(std::vector<std::string> pin_names);
+std::vector<float>       pin_timings(std::vector<std::string> pin_names);
 std::vector<std::string> cluster_buffer_names(float cluster_threshold,
                                               bool  find_superior = true);
 std::vector<std::string> cluster_inverter_names(float cluster_threshold,
@@ -35,12 +35,17 @@
 #include <tcl.h>
 #include "Def/DefReader.hpp"
 #include "Def/DefWriter.hpp"
+#include "Def/EcoReader.hpp"
+#include "Def/EcoWriter.hpp"
 #include "Lef/LefReader.hpp"
 #include "Liberty/LibertyReader.hpp"
+#include "Sta/TimingSnapshotWriter.hpp"
+#include "Transform/TransformManifest.hpp"
 #include "OpenPhySyn/PsnLogger/PsnLogger.hpp"
 #include "OpenPhySyn/Sta/DatabaseSta.hpp"
 #include "OpenPhySyn/Sta/DatabaseStaNetwork.hpp"
 #include "OpenPhySyn/Utils/PsnGlobal.hpp"
+#include "OpenPhySyn/Utils/SnapshotWriter.hpp"
 #include "PsnException/FileException.hpp"
 #include "PsnException/FluteInitException.hpp"
 #include "PsnException/NoTechException.hpp"
@@ -59,6 +64,8 @@
 #include "opendp/Opendp.h"
 #endif
 
+#include <zlib.h>
+
 extern "C"
 {
     extern int Psn_Init(Tcl_Interp* interp);
@@ -147,6 +154,7 @@ Psn::initialize(sta::DatabaseSta* sta, bool load_transforms, Tcl_Interp* interp,
 
 Psn::~Psn()
 {
+    db_writer_.reset();
     delete db_handler_;
     delete sta_;
     if (db_ != nullptr)
@@ -163,6 +171,8 @@ Psn::readDef(const char* path)
     {
         int rc = reader.read(path);
         sta_->postReadDef(db_->getChip()->getBlock());
+        handler()->resetNetlistCache();
+        handler()->clearEcoChanges();
         return rc;
     }
     catch (FileException& e)
@@ -178,9 +188,13 @@ Psn::readDef(const char* path)
 }
 
 int
-Psn::readLib(const char* path)
+Psn::readLib(const char* path, const char* cache_dir, bool validate_cache)
 {
     LibertyReader reader(sta_);
+    if (cache_dir)
+    {
+        reader.setCache(cache_dir, validate_cache);
+    }
     try
     {
         liberty_ = reader.read(path);
@@ -198,6 +212,38 @@ Psn::readLib(const char* path)
     }
 }
 
+int
+Psn::readLibs(const std::vector<std::string>& paths, const char* cache_dir,
+              bool validate_cache)
+{
+    LibertyReader reader(sta_);
+    if (cache_dir)
+    {
+        reader.setCache(cache_dir, validate_cache);
+    }
+    // File access and cache lookups overlap, parsing and linking stay in
+    // order since the liberty parser and the network are not thread-safe.
+    reader.prefetch(paths);
+    for (auto& path : paths)
+    {
+        try
+        {
+            liberty_ = reader.read(path.c_str());
+            sta_->getDbNetwork()->readLibertyAfter(liberty_);
+            if (!liberty_)
+            {
+                return -1;
+            }
+        }
+        catch (PsnException& e)
+        {
+            PSN_LOG_ERROR(e.what());
+            return -1;
+        }
+    }
+    return paths.size();
+}
+
 int
 Psn::readLef(const char* path, bool import_library, bool import_tech)
 {
@@ -249,6 +295,22 @@ Psn::readLef(const char* path, bool import_library, bool import_tech)
     }
 }
 
+int
+Psn::readLefs(const std::vector<std::string>& paths, bool import_library,
+              bool import_tech)
+{
+    FileUtils::readAhead(paths);
+    for (auto& path : paths)
+    {
+        int rc = readLef(path.c_str(), import_library, import_tech);
+        if (rc <= 0)
+        {
+            return rc;
+        }
+    }
+    return paths.size();
+}
+
 int
 Psn::writeDef(const char* path)
 {
@@ -264,30 +326,165 @@ Psn::writeDef(const char* path)
     }
 }
 
+int
+Psn::writeEco(const char* path)
+{
+    EcoWriter writer(handler());
+    try
+    {
+        return writer.write(path);
+    }
+    catch (PsnException& e)
+    {
+        PSN_LOG_ERROR(e.what());
+        return -1;
+    }
+}
+
+int
+Psn::readEco(const char* path)
+{
+    EcoReader reader(handler());
+    try
+    {
+        return reader.read(path);
+    }
+    catch (PsnException& e)
+    {
+        PSN_LOG_ERROR(e.what());
+        return -1;
+    }
+}
+
+int
+Psn::writeTimingSnapshot(const char* path)
+{
+    if (!hasDesign())
+    {
+        PSN_LOG_ERROR("Could not find any loaded design.");
+        return -1;
+    }
+    TimingSnapshotWriter writer(handler());
+    try
+    {
+        return writer.write(path);
+    }
+    catch (PsnException& e)
+    {
+        PSN_LOG_ERROR(e.what());
+        return -1;
+    }
+}
+
 int
 Psn::readDatabase(const char* path)
 {
+    if (db_writer_ && db_writer_->path() == path)
+    {
+        waitDatabaseWrite();
+    }
     FILE* stream = fopen(path, "r");
-    if (stream)
+    if (!stream)
+    {
+        return 0;
+    }
+    // Snapshots written with compression are inflated in memory first.
+    int  first  = fgetc(stream);
+    int  second = fgetc(stream);
+    bool is_gz  = first == 0x1f && second == 0x8b;
+    std::string contents;
+    if (is_gz)
     {
-        db_->read(stream);
-        sta_->postReadDb(db_);
         fclose(stream);
-        return 1;
+        gzFile gz_stream = gzopen(path, "rb");
+        if (!gz_stream)
+        {
+            return 0;
+        }
+        std::vector<char> buffer(1 << 20);
+        int               count;
+        while ((count = gzread(gz_stream, buffer.data(), buffer.size())) > 0)
+        {
+            contents.append(buffer.data(), count);
+        }
+        gzclose(gz_stream);
+        if (count < 0 || contents.empty())
+        {
+            return 0;
+        }
+        stream = fmemopen(&contents[0], contents.size(), "r");
+        if (!stream)
+        {
+            return 0;
+        }
     }
-    return 0;
+    else
+    {
+        rewind(stream);
+    }
+    db_->read(stream);
+    sta_->postReadDb(db_);
+    handler()->resetNetlistCache();
+    handler()->clearEcoChanges();
+    fclose(stream);
+    return 1;
 }
 int
-Psn::writeDatabase(const char* path)
+Psn::writeDatabase(const char* path, bool async, bool compress)
 {
-    FILE* stream = fopen(path, "w");
-    if (stream)
+    if (!async && !compress)
+    {
+        FILE* stream = fopen(path, "w");
+        if (stream)
+        {
+            db_->write(stream);
+            fclose(stream);
+            return 1;
+        }
+        return 0;
+    }
+    if (!db_writer_)
+    {
+        db_writer_.reset(new SnapshotWriter);
+    }
+    if (!db_writer_->write(db_, path, compress))
+    {
+        PSN_LOG_ERROR("Failed to snapshot the database for {}", path);
+        return 0;
+    }
+    if (!async)
+    {
+        return waitDatabaseWrite();
+    }
+    PSN_LOG_INFO("Writing {} in the background", path);
+    return 1;
+}
+int
+Psn::waitDatabaseWrite()
+{
+    if (!db_writer_)
     {
-        db_->write(stream);
-        fclose(stream);
         return 1;
     }
-    return 0;
+    if (!db_writer_->wait())
+    {
+        PSN_LOG_ERROR("Failed to write {}", db_writer_->path());
+        return 0;
+    }
+    return 1;
+}
+std::string
+Psn::databaseWriteStatus() const
+{
+    if (!db_writer_)
+    {
+        return "idle";
+    }
+    if (db_writer_->isRunning())
+    {
+        return "running";
+    }
+    return db_writer_->hasFailed() ? "failed" : "done";
 }
 
 Database*
@@ -366,6 +563,27 @@ Psn::loadTransforms()
     std::vector<std::string> transforms_dirs =
         StringUtils::split(transforms_paths, ":");
 
+    // Transforms linked into the binary take precedence over plugins with the
+    // same name.
+    for (auto& builtin : staticTransforms())
+    {
+        std::string tr_name(builtin.name);
+        if (transforms_info_.count(tr_name))
+        {
+            continue;
+        }
+        PSN_LOG_DEBUG("Registering built-in transform {}", tr_name);
+        transforms_info_[tr_name] = TransformInfo(
+            builtin.name, builtin.help, builtin.version, builtin.description);
+        transforms_[tr_name] = builtin.load();
+        load_count++;
+    }
+
+    // With lazy loading, plugins indexed in the directory manifest are only
+    // opened and instantiated on their first run.
+    const char* lazy_env = std::getenv("PSN_LAZY_TRANSFORMS");
+    bool        lazy     = lazy_env && std::string(lazy_env) != "0";
+
     for (auto& transform_parent_path : transforms_dirs)
     {
         if (!transform_parent_path.length())
@@ -378,42 +596,103 @@ Psn::loadTransforms()
         }
         std::vector<std::string> transforms_paths =
             FileUtils::readDirectory(transform_parent_path, true);
+        TransformManifest manifest(transform_parent_path);
+        if (lazy)
+        {
+            manifest.read();
+            manifest.retain(transforms_paths);
+        }
         for (auto& path : transforms_paths)
         {
+            const TransformInfo* info = lazy ? manifest.find(path) : nullptr;
+            if (info)
+            {
+                PSN_LOG_DEBUG("Indexed transform {}", path);
+                load_count += registerTransform(*info, path, nullptr);
+                continue;
+            }
             PSN_LOG_DEBUG("Loading transform {}", path);
-            handlers_.push_back(psn::TransformHandler(path));
+            auto handler = std::make_shared<TransformHandler>(path);
+            TransformInfo handler_info(handler->name(), handler->help(),
+                                       handler->version(),
+                                       handler->description());
+            if (lazy)
+            {
+                manifest.update(path, handler_info);
+            }
+            load_count += registerTransform(handler_info, path, handler);
+        }
+        if (lazy && manifest.isModified() && !manifest.write())
+        {
+            PSN_LOG_DEBUG("Could not update the transform manifest under {}",
+                          transform_parent_path);
         }
 
         PSN_LOG_DEBUG("Found {} transforms under {}.", transforms_paths.size(),
                       transform_parent_path);
     }
-
-    for (auto tr : handlers_)
+    if (!lazy)
     {
-        std::string tr_name(tr.name());
-        if (!transforms_.count(tr_name))
+        std::vector<std::string> transform_names;
+        for (auto& itr : pending_transforms_)
         {
-            auto transform            = tr.load();
-            transforms_[tr_name]      = transform;
-            transforms_info_[tr_name] = TransformInfo(
-                tr_name, tr.help(), tr.version(), tr.description());
-            load_count++;
+            transform_names.push_back(itr.first);
         }
-        else
+        for (auto& transform_name : transform_names)
         {
-            PSN_LOG_WARN(
-                "Transform {} was already loaded, discarding subsequent loads",
-                tr_name);
+            instantiateTransform(transform_name);
         }
     }
     PSN_LOG_INFO("Loaded {} transforms.", load_count);
     return load_count;
 }
 
+int
+Psn::registerTransform(const TransformInfo& info, const std::string& path,
+                       std::shared_ptr<TransformHandler> handler)
+{
+    std::string tr_name(info.name());
+    if (transforms_info_.count(tr_name))
+    {
+        PSN_LOG_WARN(
+            "Transform {} was already loaded, discarding subsequent loads",
+            tr_name);
+        return 0;
+    }
+    transforms_info_[tr_name]    = info;
+    pending_transforms_[tr_name] = std::make_pair(path, handler);
+    return 1;
+}
+
+std::shared_ptr<PsnTransform>
+Psn::instantiateTransform(const std::string& transform_name)
+{
+    auto transform = transforms_.find(transform_name);
+    if (transform != transforms_.end())
+    {
+        return transform->second;
+    }
+    auto pending = pending_transforms_.find(transform_name);
+    if (pending == pending_transforms_.end())
+    {
+        throw TransformNotFoundException();
+    }
+    auto handler = pending->second.second;
+    if (!handler)
+    {
+        PSN_LOG_DEBUG("Loading transform {}", pending->second.first);
+        handler = std::make_shared<TransformHandler>(pending->second.first);
+    }
+    handlers_.push_back(*handler);
+    transforms_[transform_name] = handler->load();
+    pending_transforms_.erase(pending);
+    return transforms_[transform_name];
+}
+
 bool
 Psn::hasTransform(std::string transform_name)
 {
-    return transforms_.count(transform_name);
+    return transforms_info_.count(transform_name);
 }
 
 int
@@ -426,7 +705,7 @@ Psn::runTransform(std::string transform_name, std::vector<std::string> args)
     }
     try
     {
-        if (!transforms_.count(transform_name))
+        if (!transforms_info_.count(transform_name))
         {
             throw TransformNotFoundException();
         }
@@ -444,7 +723,8 @@ Psn::runTransform(std::string transform_name, std::vector<std::string> args)
         {
 
             PSN_LOG_INFO("Invoking {} transform", transform_name);
-            int rc = transforms_[transform_name]->run(this, args);
+            auto transform = instantiateTransform(transform_name);
+            int  rc        = transform->run(this, args);
             sta_->ensureLevelized();
             handler()->resetDelays();
             PSN_LOG_INFO("Finished {} transform ({})", transform_name, rc);
@@ -658,8 +938,15 @@ Psn::printCommands(bool raw_str)
     std::string commands_str;
     commands_str +=
         "design_area			Report design total cell area\n"
-        "export_db			Export OpenDB database file\n"
+        "export_db			Export OpenDB database file, optionally "
+        "in the background and compressed\n"
+        "export_db_status		Report the state of the last "
+        "background database export\n"
         "export_def			Export design DEF file\n"
+        "export_eco			Export the netlist edits made since "
+        "the design was loaded\n"
+        "export_timing			Export per-pin timing and endpoint "
+        "worst paths as a binary snapshot\n"
         "gate_clone			Perform load-driven gate cloning\n"
         "get_database			Return OpenDB database object\n"
         "get_database_handler		Return OpenPhySyn database "
@@ -673,9 +960,14 @@ Psn::printCommands(bool raw_str)
         "help				Print this help\n"
         "import_db			Import OpenDB database file\n"
         "import_def			Import design DEF file\n"
+        "import_eco			Apply an ECO file to the loaded "
+        "design\n"
         "import_lef			Import technology LEF file\n"
+        "import_lefs			Import a list of LEF files\n"
         "import_lib			Alias for import_liberty\n"
-        "import_liberty			Import liberty file\n"
+        "import_libs			Import a list of liberty files\n"
+        "import_liberty			Import liberty file, optionally "
+        "through a binary cache directory\n"
         "link				Alias for link_design\n"
         "link_design			Link design top module\n"
         "make_steiner_tree		Create steiner tree around "
@@ -687,6 +979,10 @@ Psn::printCommands(bool raw_str)
         "optimize_power			Perform power optimization\n"
         "pin_swap			Perform timing optimization by "
         "commutative pin swapping\n"
+        "pin_slacks			Report worst slack for a list of "
+        "pins\n"
+        "pin_timings			Report slack, slew, load, slew limit, "
+        "capacitance limit and violation for a list of pins\n"
         "print_liberty_cells		Print liberty cells available "
         "in the  loaded library\n"
         "print_license			Print license information\n"
@@ -715,8 +1011,12 @@ Psn::printCommands(bool raw_str)
         "resistance/capacitance per micron, you can also specify technology "
         "layer\n"
         "transform			Run loaded transform\n"
+        "utilization			Report design cell area over core "
+        "area\n"
         "version				Alias for "
-        "print_version\n";
+        "print_version\n"
+        "wait_export_db			Wait for the background database "
+        "export to finish\n";
     PSN_LOG_RAW("{}", commands_str);
 }
 void
@@ -733,7 +1033,8 @@ Psn::printTransforms(bool raw_str)
     }
     PSN_LOG_RAW("");
     std::string transform_str;
-    for (auto it = transforms_.begin(); it != transforms_.end(); ++it)
+    for (auto it = transforms_info_.begin(); it != transforms_info_.end();
+         ++it)
     {
         transform_str = it->first;
         transform_str += " (";
@@ -930,6 +1231,8 @@ Psn::linkDesign(const char* design_name)
 {
     int rc = sta_->linkDesign(design_name);
     sta_->postReadDb(db_);
+    handler()->resetNetlistCache();
+    handler()->clearEcoChanges();
     return rc;
 }
 
@@ -966,7 +1269,25 @@ Psn::clearDatabase()
 int
 Psn::initializeFlute()
 {
+    // When PSN_FLUTE_LUT names a file, the parsed lookup tables are kept
+    // there as a binary image that is mapped read-only, sharing its pages
+    // between concurrent sessions. Without it the tables are parsed.
+    std::string image_path;
+    const char* env_path = std::getenv("PSN_FLUTE_LUT");
+    if (env_path)
+    {
+        image_path = std::string(env_path);
+    }
+    if (image_path.length() && Flute::readLUTImage(image_path.c_str()))
+    {
+        PSN_LOG_DEBUG("Mapped Flute LUT image {}", image_path);
+        return 1;
+    }
     Flute::readLUT();
+    if (image_path.length() && !Flute::writeLUTImage(image_path.c_str()))
+    {
+        PSN_LOG_DEBUG("Could not write Flute LUT image {}", image_path);
+    }
     return 1;
 }
 } // namespace psn
\ No newline at end of file
@@ -119,6 +119,40 @@ DatabaseSta::readLiberty(const char* filename, Corner* corner,
     return lib;
 }
 
+void
+DatabaseSta::setLibertyFileReader(LibertyFileReader reader)
+{
+    liberty_file_reader_ = reader;
+}
+
+LibertyLibrary*
+DatabaseSta::readLibertyFile(const char* filename, Corner* corner,
+                             const MinMaxAll* min_max, bool infer_latches,
+                             Network* network)
+{
+    if (!liberty_file_reader_)
+    {
+        return Sta::readLibertyFile(filename, corner, min_max, infer_latches,
+                                    network);
+    }
+    LibertyLibrary* liberty =
+        liberty_file_reader_(filename, infer_latches, network);
+    if (liberty)
+    {
+        if (min_max == MinMaxAll::all())
+        {
+            readLibertyAfter(liberty, corner, MinMax::min());
+            readLibertyAfter(liberty, corner, MinMax::max());
+        }
+        else
+        {
+            readLibertyAfter(liberty, corner, min_max->asMinMax());
+        }
+        network_->readLibertyAfter(liberty);
+    }
+    return liberty;
+}
+
 Slack
 DatabaseSta::netSlack(const dbNet* db_net, const MinMax* min_max)
 {
@@ -0,0 +1,240 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "OpenPhySyn/Sta/TimingSnapshot.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace psn
+{
+
+const char TimingSnapshot::magic[8] = {'P', 'S', 'N', 'T',
+                                       'I', 'M', 'E', 0};
+const uint32_t TimingSnapshot::version = 2;
+
+TimingSnapshot::TimingSnapshot() : data_(nullptr), size_(0), header_(nullptr)
+{
+}
+
+TimingSnapshot::~TimingSnapshot()
+{
+    close();
+}
+
+size_t
+TimingSnapshot::fileSize(uint32_t pin_count, uint32_t endpoint_count,
+                         uint32_t point_count, uint64_t names_size)
+{
+    return sizeof(TimingSnapshotHeader) +
+           pin_count * (sizeof(uint32_t) + PinColumnCount * sizeof(float)) +
+           endpoint_count * (3 * sizeof(uint32_t) + sizeof(float)) +
+           point_count *
+               (sizeof(uint32_t) + 4 * sizeof(float) + sizeof(uint8_t)) +
+           names_size;
+}
+
+bool
+TimingSnapshot::open(const std::string& path)
+{
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(TimingSnapshotHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    data_   = data;
+    size_   = st.st_size;
+    header_ = static_cast<const TimingSnapshotHeader*>(data);
+    if (std::memcmp(header_->magic, magic, sizeof(magic)) != 0 ||
+        header_->version != version ||
+        fileSize(header_->pin_count, header_->endpoint_count,
+                 header_->point_count, header_->names_size) != size_ ||
+        (header_->names_size && static_cast<const char*>(data)[size_ - 1]))
+    {
+        close();
+        return false;
+    }
+
+    uint32_t pins      = header_->pin_count;
+    uint32_t endpoints = header_->endpoint_count;
+    uint32_t points    = header_->point_count;
+    pin_names_   = reinterpret_cast<const uint32_t*>(header_ + 1);
+    pin_columns_ = reinterpret_cast<const float*>(pin_names_ + pins);
+    endpoint_pins_ =
+        reinterpret_cast<const uint32_t*>(pin_columns_ + PinColumnCount * pins);
+    endpoint_slacks_ =
+        reinterpret_cast<const float*>(endpoint_pins_ + endpoints);
+    endpoint_path_begin_ =
+        reinterpret_cast<const uint32_t*>(endpoint_slacks_ + endpoints);
+    endpoint_path_size_ = endpoint_path_begin_ + endpoints;
+    point_pins_         = endpoint_path_size_ + endpoints;
+    point_arrivals_  = reinterpret_cast<const float*>(point_pins_ + points);
+    point_requireds_ = point_arrivals_ + points;
+    point_slacks_    = point_requireds_ + points;
+    point_slews_     = point_slacks_ + points;
+    point_rises_     = reinterpret_cast<const uint8_t*>(point_slews_ + points);
+    names_           = reinterpret_cast<const char*>(point_rises_ + points);
+
+    // Indices are checked once so the accessors can trust them.
+    for (uint32_t i = 0; i < pins; i++)
+    {
+        if (pin_names_[i] >= header_->names_size)
+        {
+            close();
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < endpoints; i++)
+    {
+        if (endpoint_pins_[i] >= pins || endpoint_path_begin_[i] > points ||
+            endpoint_path_size_[i] > points - endpoint_path_begin_[i])
+        {
+            close();
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < points; i++)
+    {
+        if (point_pins_[i] >= pins)
+        {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+TimingSnapshot::close()
+{
+    if (data_)
+    {
+        munmap(data_, size_);
+    }
+    data_   = nullptr;
+    size_   = 0;
+    header_ = nullptr;
+}
+
+bool
+TimingSnapshot::isOpen() const
+{
+    return header_ != nullptr;
+}
+
+uint32_t
+TimingSnapshot::pinCount() const
+{
+    return header_ ? header_->pin_count : 0;
+}
+
+uint32_t
+TimingSnapshot::endpointCount() const
+{
+    return header_ ? header_->endpoint_count : 0;
+}
+
+uint32_t
+TimingSnapshot::pointCount() const
+{
+    return header_ ? header_->point_count : 0;
+}
+
+const char*
+TimingSnapshot::pinName(uint32_t pin) const
+{
+    return names_ + pin_names_[pin];
+}
+
+uint32_t
+TimingSnapshot::findPin(const std::string& name) const
+{
+    for (uint32_t i = 0; i < pinCount(); i++)
+    {
+        if (name == pinName(i))
+        {
+            return i;
+        }
+    }
+    return pinCount();
+}
+
+const float*
+TimingSnapshot::pinColumn(PinColumn column) const
+{
+    return pin_columns_ + column * header_->pin_count;
+}
+
+const uint32_t*
+TimingSnapshot::endpointPins() const
+{
+    return endpoint_pins_;
+}
+
+const float*
+TimingSnapshot::endpointSlacks() const
+{
+    return endpoint_slacks_;
+}
+
+std::vector<TimingSnapshotPoint>
+TimingSnapshot::endpointPath(uint32_t endpoint) const
+{
+    std::vector<TimingSnapshotPoint> path;
+    uint32_t begin = endpoint_path_begin_[endpoint];
+    uint32_t end   = begin + endpoint_path_size_[endpoint];
+    path.reserve(end - begin);
+    for (uint32_t i = begin; i < end; i++)
+    {
+        path.push_back({point_pins_[i], point_rises_[i] != 0,
+                        point_arrivals_[i], point_requireds_[i],
+                        point_slacks_[i], point_slews_[i]});
+    }
+    return path;
+}
+} // namespace psn
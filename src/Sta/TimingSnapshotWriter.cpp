@@ -0,0 +1,282 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "TimingSnapshotWriter.hpp"
+#include "OpenPhySyn/Sta/DatabaseSta.hpp"
+#include "OpenPhySyn/Sta/DatabaseStaNetwork.hpp"
+#include "OpenPhySyn/Sta/TimingSnapshot.hpp"
+#include "PsnException/FileException.hpp"
+#include "PsnLogger/PsnLogger.hpp"
+#include "sta/Corner.hh"
+#include "sta/Graph.hh"
+#include "sta/MinMax.hh"
+#include "sta/PathAnalysisPt.hh"
+#include "sta/Search.hh"
+#include "sta/Transition.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace psn
+{
+namespace
+{
+// A snapshot column streamed to an anonymous temporary file, so the memory
+// used by the writer does not grow with the design.
+class ColumnBuffer
+{
+public:
+    ColumnBuffer() : file_(std::tmpfile()), size_(0)
+    {
+        if (!file_)
+        {
+            throw FileException();
+        }
+    }
+    ~ColumnBuffer()
+    {
+        std::fclose(file_);
+    }
+    ColumnBuffer(const ColumnBuffer&) = delete;
+    ColumnBuffer& operator=(const ColumnBuffer&) = delete;
+
+    template<typename T>
+    void
+    append(T value)
+    {
+        append(&value, sizeof(value));
+    }
+    void
+    append(const void* data, size_t size)
+    {
+        if (std::fwrite(data, 1, size, file_) != size)
+        {
+            throw FileException();
+        }
+        size_ += size;
+    }
+    size_t
+    size() const
+    {
+        return size_;
+    }
+    void
+    copyTo(std::ostream& out)
+    {
+        char   buffer[1 << 16];
+        size_t count;
+        std::rewind(file_);
+        while ((count = std::fread(buffer, 1, sizeof(buffer), file_)) > 0)
+        {
+            out.write(buffer, count);
+        }
+        if (std::ferror(file_))
+        {
+            throw FileException();
+        }
+    }
+
+private:
+    std::FILE* file_;
+    size_t     size_;
+};
+} // namespace
+
+TimingSnapshotWriter::TimingSnapshotWriter(DatabaseHandler* handler)
+    : handler_(handler)
+{
+}
+
+int
+TimingSnapshotWriter::write(const char* path)
+{
+    DatabaseSta*        sta     = handler_->sta();
+    DatabaseStaNetwork* network = handler_->network();
+    sta->ensureLevelized();
+    sta->search()->findAllArrivals();
+    sta->findRequireds();
+
+    // Every column is read at the same analysis point, so arrivals, slacks
+    // and slews of one snapshot belong to one corner.
+    auto path_ap  = sta->cmdCorner()->findPathAnalysisPt(sta::MinMax::max());
+    auto dcalc_ap = path_ap->dcalcAnalysisPt();
+    const sta::RiseFall* rise_fall[2] = {sta::RiseFall::rise(),
+                                         sta::RiseFall::fall()};
+
+    uint32_t     pin_count = 0;
+    ColumnBuffer pin_names;
+    ColumnBuffer pin_columns[TimingSnapshot::PinColumnCount];
+    ColumnBuffer names;
+    std::unordered_map<InstanceTerm*, uint32_t> pin_index;
+
+    sta::VertexIterator itr(network->graph());
+    while (itr.hasNext())
+    {
+        Vertex* vtx = itr.next();
+        if (vtx->isBidirectDriver())
+        {
+            continue;
+        }
+        InstanceTerm* pin = vtx->pin();
+        pin_index[pin]    = pin_count++;
+        pin_names.append<uint32_t>(names.size());
+        std::string pin_name = network->pathName(pin);
+        names.append(pin_name.c_str(), pin_name.size() + 1);
+        for (int i = 0; i < 2; i++)
+        {
+            auto rf = rise_fall[i];
+            pin_columns[TimingSnapshot::ArrivalRise + i].append<float>(
+                sta->vertexArrival(vtx, rf, path_ap));
+            pin_columns[TimingSnapshot::RequiredRise + i].append<float>(
+                sta->vertexRequired(vtx, rf, path_ap));
+            pin_columns[TimingSnapshot::SlackRise + i].append<float>(
+                sta->vertexSlack(vtx, rf, path_ap));
+            pin_columns[TimingSnapshot::SlewRise + i].append<float>(
+                sta->vertexSlew(vtx, rf, dcalc_ap));
+        }
+    }
+
+    uint32_t     endpoint_count = 0;
+    uint32_t     point_count    = 0;
+    ColumnBuffer endpoint_pins;
+    ColumnBuffer endpoint_slacks;
+    ColumnBuffer endpoint_path_begin;
+    ColumnBuffer endpoint_path_size;
+    ColumnBuffer point_pins;
+    ColumnBuffer point_arrivals;
+    ColumnBuffer point_requireds;
+    ColumnBuffer point_slacks;
+    ColumnBuffer point_slews;
+    ColumnBuffer point_rises;
+    for (auto& vert : *sta->search()->endpoints())
+    {
+        auto endpoint = pin_index.find(vert->pin());
+        if (endpoint == pin_index.end())
+        {
+            continue;
+        }
+        endpoint_count++;
+        endpoint_pins.append<uint32_t>(endpoint->second);
+        endpoint_slacks.append<float>(
+            std::min(sta->vertexSlack(vert, sta::RiseFall::rise(), path_ap),
+                     sta->vertexSlack(vert, sta::RiseFall::fall(), path_ap)));
+        endpoint_path_begin.append<uint32_t>(point_count);
+        uint32_t path_size = 0;
+        for (auto& point : handler_->worstSlackPath(vert->pin()))
+        {
+            auto point_pin = pin_index.find(point.pin());
+            if (point_pin == pin_index.end())
+            {
+                continue;
+            }
+            auto rf = point.isRise() ? sta::RiseFall::rise()
+                                     : sta::RiseFall::fall();
+            point_pins.append<uint32_t>(point_pin->second);
+            point_arrivals.append<float>(point.arrival());
+            point_requireds.append<float>(point.required());
+            point_slacks.append<float>(point.slack());
+            point_slews.append<float>(
+                sta->vertexSlew(handler_->vertex(point.pin()), rf, dcalc_ap));
+            point_rises.append<uint8_t>(point.isRise());
+            path_size++;
+        }
+        endpoint_path_size.append<uint32_t>(path_size);
+        point_count += path_size;
+    }
+
+    TimingSnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TimingSnapshot::magic, sizeof(header.magic));
+    header.version        = TimingSnapshot::version;
+    header.pin_count      = pin_count;
+    header.endpoint_count = endpoint_count;
+    header.point_count    = point_count;
+    header.names_size     = names.size();
+
+    // Written aside and renamed so readers mapping the previous snapshot
+    // never see a partial file.
+    std::string tmp_path =
+        std::string(path) + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(tmp_path, std::ios::binary);
+        if (!out.is_open())
+        {
+            throw FileException();
+        }
+        try
+        {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            pin_names.copyTo(out);
+            for (auto& column : pin_columns)
+            {
+                column.copyTo(out);
+            }
+            endpoint_pins.copyTo(out);
+            endpoint_slacks.copyTo(out);
+            endpoint_path_begin.copyTo(out);
+            endpoint_path_size.copyTo(out);
+            point_pins.copyTo(out);
+            point_arrivals.copyTo(out);
+            point_requireds.copyTo(out);
+            point_slacks.copyTo(out);
+            point_slews.copyTo(out);
+            point_rises.copyTo(out);
+            names.copyTo(out);
+        }
+        catch (FileException&)
+        {
+            out.close();
+            std::remove(tmp_path.c_str());
+            throw;
+        }
+        out.close();
+        if (!out)
+        {
+            std::remove(tmp_path.c_str());
+            throw FileException();
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path) != 0)
+    {
+        std::remove(tmp_path.c_str());
+        throw FileException();
+    }
+    PSN_LOG_INFO("Wrote timing of {} pins and {} endpoints to {}",
+                 header.pin_count, header.endpoint_count, path);
+    return header.pin_count;
+}
+
+} // namespace psn
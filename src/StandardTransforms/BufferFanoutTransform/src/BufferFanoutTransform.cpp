@@ -40,9 +40,136 @@
 namespace psn
 {
 
+void
+BufferFanoutTransform::bisect(std::vector<FanoutNode>& nodes, int begin,
+                              int end, int groups,
+                              std::vector<std::pair<int, int>>& clusters)
+{
+    if (groups <= 1 || end - begin <= 1)
+    {
+        clusters.push_back(std::make_pair(begin, end));
+        return;
+    }
+    int min_x = nodes[begin].location.getX();
+    int max_x = min_x;
+    int min_y = nodes[begin].location.getY();
+    int max_y = min_y;
+    for (int i = begin + 1; i < end; i++)
+    {
+        min_x = std::min(min_x, nodes[i].location.getX());
+        max_x = std::max(max_x, nodes[i].location.getX());
+        min_y = std::min(min_y, nodes[i].location.getY());
+        max_y = std::max(max_y, nodes[i].location.getY());
+    }
+    bool split_x = (max_x - min_x) >= (max_y - min_y);
+
+    // Split the nodes proportionally to the number of groups on each side so
+    // that every cluster ends up with at most max_fanout nodes.
+    int left_groups = groups / 2;
+    int mid = begin + (int)((long long)(end - begin) * left_groups / groups);
+    std::nth_element(nodes.begin() + begin, nodes.begin() + mid,
+                     nodes.begin() + end,
+                     [split_x](const FanoutNode& a, const FanoutNode& b) {
+                         if (split_x)
+                         {
+                             return a.location.getX() < b.location.getX();
+                         }
+                         return a.location.getY() < b.location.getY();
+                     });
+    bisect(nodes, begin, mid, left_groups, clusters);
+    bisect(nodes, mid, end, groups - left_groups, clusters);
+}
+
+int
+BufferFanoutTransform::bufferClustered(
+    Psn* psn_inst, Net* net, LibraryCell* cell, LibraryTerm* cell_in_pin,
+    LibraryTerm* cell_out_pin, std::vector<InstanceTerm*>& fanout_pins,
+    int max_fanout, int& buffer_index, int& net_index)
+{
+    DatabaseHandler& handler = *(psn_inst->handler());
+
+    std::vector<FanoutNode> nodes;
+    nodes.reserve(fanout_pins.size());
+    for (auto& pin : fanout_pins)
+    {
+        nodes.push_back({pin, handler.location(pin)});
+    }
+
+    // Build the tree bottom-up: cluster the current level into groups of at
+    // most max_fanout nodes, drive each group from a buffer placed at its
+    // centroid and repeat with the new buffers until the source can drive
+    // them directly.
+    int                              create_buffer_count = 0;
+    std::vector<std::pair<int, int>> clusters;
+    std::vector<FanoutNode>          next_nodes;
+    while ((int)nodes.size() > max_fanout)
+    {
+        int groups = (nodes.size() + max_fanout - 1) / max_fanout;
+        clusters.clear();
+        bisect(nodes, 0, nodes.size(), groups, clusters);
+        next_nodes.clear();
+        next_nodes.reserve(clusters.size());
+        for (auto& cluster : clusters)
+        {
+            long long sum_x = 0;
+            long long sum_y = 0;
+            for (int i = cluster.first; i < cluster.second; i++)
+            {
+                sum_x += nodes[i].location.getX();
+                sum_y += nodes[i].location.getY();
+            }
+            int   cluster_size = cluster.second - cluster.first;
+            Point centroid(sum_x / cluster_size, sum_y / cluster_size);
+
+            auto buf_name = handler.generateInstanceName("fanout_buf_",
+                                                         buffer_index);
+            auto net_name   = handler.generateNetName(net_index);
+            auto new_buffer = handler.createInstance(buf_name.c_str(), cell);
+            if (!new_buffer)
+            {
+                PSN_LOG_CRITICAL("Failed to create buffer {}, "
+                                 "cannot recover the design, you may need "
+                                 "to restart the flow.",
+                                 buf_name);
+                return create_buffer_count;
+            }
+            create_buffer_count++;
+            Net* new_net = handler.createNet(net_name.c_str());
+            if (!new_net)
+            {
+                PSN_LOG_CRITICAL("Failed to create net {}, "
+                                 "cannot recover the design, you may need "
+                                 "to restart the flow.",
+                                 net_name);
+                return create_buffer_count;
+            }
+            handler.setLocation(new_buffer, centroid);
+            handler.connect(new_net, new_buffer, cell_out_pin);
+            for (int i = cluster.first; i < cluster.second; i++)
+            {
+                handler.connect(new_net, nodes[i].pin);
+            }
+            InstanceTerm* buffer_in_pin = nullptr;
+            handler.forEachInputPin(new_buffer, [&](InstanceTerm* pin) {
+                if (handler.libraryPin(pin) == cell_in_pin)
+                {
+                    buffer_in_pin = pin;
+                }
+            });
+            next_nodes.push_back({buffer_in_pin, centroid});
+        }
+        nodes.swap(next_nodes);
+    }
+    for (auto& node : nodes)
+    {
+        handler.connect(net, node.pin);
+    }
+    return create_buffer_count;
+}
+
 int
 BufferFanoutTransform::buffer(Psn* psn_inst, int max_fanout,
-                              std::string buffer_cell)
+                              std::string buffer_cell, bool clustered)
 {
 
     DatabaseHandler& handler = *(psn_inst->handler());
@@ -93,6 +220,8 @@ BufferFanoutTransform::buffer(Psn* psn_inst, int max_fanout,
     auto clock_pins = handler.clockPins();
 
     int create_buffer_count = 0;
+    int buffer_index        = 0;
+    int net_index           = 0;
 
     std::vector<int> current_buffer;
     for (auto& net : high_fanout_nets)
@@ -128,6 +257,13 @@ BufferFanoutTransform::buffer(Psn* psn_inst, int max_fanout,
             { // Top level ports are not disconnected by disconnect all.
                 handler.connect(net, source_pin);
             }
+            if (clustered)
+            {
+                create_buffer_count += bufferClustered(
+                    psn_inst, net, cell, cell_in_pin, cell_out_pin,
+                    fanout_pins, max_fanout, buffer_index, net_index);
+                continue;
+            }
 
             int current_sink_count = 0;
             int levels             = buffer_hier.size();
@@ -337,6 +473,11 @@ BufferFanoutTransform::run(Psn* psn_inst, std::vector<std::string> args)
     {
         return buffer(psn_inst, stoi(args[0]), args[1]);
     }
+    else if (args.size() == 3 && StringUtils::isNumber(args[0]) &&
+             args[2] == "cluster")
+    {
+        return buffer(psn_inst, stoi(args[0]), args[1], true);
+    }
     else
     {
         PSN_LOG_ERROR(help());
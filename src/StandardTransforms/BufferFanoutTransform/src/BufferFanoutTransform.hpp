@@ -39,8 +39,24 @@ namespace psn
 {
 class BufferFanoutTransform : public PsnTransform
 {
+private:
+    // A sink of the tree under construction: either an original sink pin or
+    // the input pin of a buffer placed at the centroid of its own sinks.
+    struct FanoutNode
+    {
+        InstanceTerm* pin;
+        Point         location;
+    };
+    int  bufferClustered(Psn* psn_inst, Net* net, LibraryCell* cell,
+                         LibraryTerm* cell_in_pin, LibraryTerm* cell_out_pin,
+                         std::vector<InstanceTerm*>& fanout_pins,
+                         int max_fanout, int& buffer_index, int& net_index);
+    void bisect(std::vector<FanoutNode>& nodes, int begin, int end,
+                int groups, std::vector<std::pair<int, int>>& clusters);
+
 public:
-    int buffer(Psn* psn_inst, int max_fanout, std::string buffer_cell);
+    int buffer(Psn* psn_inst, int max_fanout, std::string buffer_cell,
+               bool clustered = false);
 
     int              run(Psn* psn_inst, std::vector<std::string> args) override;
     std::string      bufferName(int index);
@@ -54,5 +70,5 @@ public:
 DEFINE_TRANSFORM(BufferFanoutTransform, "buffer_fanout", "1.0",
                  "Inserts buffers based on max fan-out",
                  "Usage: transform buffer_fanout "
-                 "<max_fanout> <buffer_cell>")
+                 "<max_fanout> <buffer_cell> [cluster]")
 } // namespace psn
\ No newline at end of file
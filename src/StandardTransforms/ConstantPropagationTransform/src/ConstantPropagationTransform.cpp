@@ -44,6 +44,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <set>
 #include <sstream>
 
 namespace psn
@@ -53,415 +54,298 @@ ConstantPropagationTransform::ConstantPropagationTransform() : prop_count_(0)
 {
 }
 
-//  1: Tied to the input.
-//  0: Not tied.
-// -1: Tied to the negated input.
-int
-ConstantPropagationTransform::isTiedToInput(Psn*          psn_inst,
-                                            InstanceTerm* input_term,
-                                            InstanceTerm* constant_term,
-                                            bool          constant_val)
+// Cells with more inputs are left untouched; the cofactor table of an n-input
+// cell holds 3^n entries.
+static const int max_cofactor_inputs = 6;
+static const int cofactor_unknown    = -1;
+static const int cofactor_x          = 2;
+// Results starting from cofactor_tied_input encode an output that follows
+// input (result - cofactor_tied_input) / 2, inverted if the result is odd.
+static const int cofactor_tied_input = 2;
 
+void
+ConstantPropagationTransform::buildCofactorTable(Psn*           psn_inst,
+                                                 LibraryCell*   cell,
+                                                 CofactorTable& table)
 {
-    DatabaseHandler& handler               = *(psn_inst->handler());
-    LibraryTerm*     constant_library_term = handler.libraryPin(constant_term);
-    LibraryTerm*     input_library_term    = handler.libraryPin(input_term);
-    Instance*        inst                  = handler.instance(constant_term);
-
-    InstanceTerm* out_pin = handler.outputPins(inst)[0];
-
-    bool tied_to_input = true;
-    for (int i = 0; i < 2; ++i)
+    DatabaseHandler& handler = *(psn_inst->handler());
+    table.valid              = false;
+    if (!handler.isSingleOutputCombinational(cell))
     {
-        std::unordered_map<LibraryTerm*, int> sim_vals;
-        sim_vals[constant_library_term] = constant_val;
-        sim_vals[input_library_term]    = i;
-        if (handler.evaluateFunctionExpression(out_pin, sim_vals) != i)
-        {
-            tied_to_input = false;
-            break;
-        }
+        return;
     }
-
-    if (!tied_to_input)
+    table.inputs    = handler.libraryInputPins(cell);
+    int input_count = table.inputs.size();
+    if (input_count == 0 || input_count > max_cofactor_inputs)
     {
-        for (int i = 0; i < 2; ++i)
-        {
-            std::unordered_map<LibraryTerm*, int> sim_vals;
-            sim_vals[constant_library_term] = constant_val;
-            sim_vals[input_library_term]    = i;
-            if (handler.evaluateFunctionExpression(out_pin, sim_vals) != !i)
-            {
-                return 0;
-            }
-        }
-        return -1;
+        return;
     }
-    else
+    LibraryTerm* output = handler.libraryOutputPins(cell)[0];
+    if (!output->function())
     {
-        return 1;
+        return;
     }
-}
 
-// 1: Tied to logic 1
-// 0: Tied to logic 0
-// -1: Not tied constant value
-int
-ConstantPropagationTransform::isTiedToConstant(Psn*          psn_inst,
-                                               InstanceTerm* constant_term,
-                                               bool          constant_val)
-{
-    DatabaseHandler&           handler  = *(psn_inst->handler());
-    Instance*                  inst     = handler.instance(constant_term);
-    std::vector<InstanceTerm*> in_pins  = handler.inputPins(inst);
-    InstanceTerm*              out_pin  = handler.outputPins(inst)[0];
-    int                        last_val = -1;
-    LibraryTerm* constant_library_term  = handler.libraryPin(constant_term);
-    int          in_pin_size            = in_pins.size();
-    int          premuts                = std::pow(2, in_pin_size - 1);
-    for (int i = 0; i < premuts; ++i)
-    {
-        std::unordered_map<LibraryTerm*, int> sim_vals;
-        sim_vals[constant_library_term] = constant_val;
-        int temp                        = i;
-        for (InstanceTerm* in_pin : in_pins)
-        {
-            if (in_pin == constant_term)
-            {
-                continue;
-            }
-            LibraryTerm* library_pin = handler.libraryPin(in_pin);
-            sim_vals[library_pin]    = temp & 1;
-            temp >>= 1;
-        }
-        int result = handler.evaluateFunctionExpression(out_pin, sim_vals);
-        if (last_val == -1)
+    int              minterms = 1 << input_count;
+    std::vector<int> truth_table(minterms);
+    std::unordered_map<LibraryTerm*, int> sim_vals;
+    for (int m = 0; m < minterms; m++)
+    {
+        for (int i = 0; i < input_count; i++)
         {
-            last_val = result;
+            sim_vals[table.inputs[i]] = (m >> i) & 1;
         }
-        else if (result != last_val)
+        truth_table[m] = handler.evaluateFunctionExpression(output, sim_vals);
+        if (truth_table[m] == -1)
         {
-            return -1;
+            return;
         }
     }
-    return last_val;
-}
-void
-ConstantPropagationTransform::propagateTieHiLoCell(
-    Psn* psn_inst, bool is_tiehi, InstanceTerm* constant_term, int max_depth,
-    bool invereter_replace, Instance* tiehi_cell, Instance* tielo_cell,
-    LibraryCell* inverter_lib_cell, LibraryCell* smallest_buffer_lib_cell,
-    LibraryCell* tiehi_lib_cell, LibraryCell* tielo_lib_cell,
-    std::unordered_set<Instance*>&     visited,
-    std::unordered_set<Instance*>&     deleted_inst,
-    std::unordered_set<InstanceTerm*>& deleted_pins)
-{
-    DatabaseHandler& handler       = *(psn_inst->handler());
-    Instance*        inst          = handler.instance(constant_term);
-    auto             inst_out_pins = handler.outputPins(inst);
-    if (max_depth == 0 || inst_out_pins.size() != 1 || visited.count(inst))
+    for (int i = 0; i < input_count; i++)
     {
-        return;
+        table.input_index[table.inputs[i]] = i;
     }
-    if (handler.dontTouch(inst))
+
+    int assignments = 1;
+    for (int i = 0; i < input_count; i++)
     {
-        return;
+        assignments *= 3;
     }
-
-    visited.insert(inst);
-
-    auto inst_out_pin = inst_out_pins[0];
-    auto fanout_pins  = handler.fanoutPins(handler.net(inst_out_pin), true);
-    PSN_LOG_DEBUG("propagateTieHiLoCell({} / {}: {}) [{}]", handler.name(inst),
-                  handler.name(handler.libraryCell(inst)),
-                  handler.name(inst_out_pin), is_tiehi);
-
-    for (auto& pin : fanout_pins)
+    table.results.resize(assignments);
+    std::vector<int>  free_inputs;
+    std::vector<bool> follows, inverts;
+    for (int a = 0; a < assignments; a++)
     {
-        if (deleted_pins.count(pin))
-        {
-            continue;
-        }
-        auto fanout_inst = handler.instance(pin);
-        if (!fanout_inst || fanout_inst == inst)
+        int fixed_vals = 0;
+        int digits     = a;
+        free_inputs.clear();
+        for (int i = 0; i < input_count; i++)
         {
-            continue;
-        }
-        auto fanout_inst_input_pins = handler.inputPins(fanout_inst);
-        if (!handler.isSingleOutputCombinational(fanout_inst))
-        {
-            continue;
+            int val = digits % 3;
+            digits /= 3;
+            if (val == cofactor_x)
+            {
+                free_inputs.push_back(i);
+            }
+            else
+            {
+                fixed_vals |= val << i;
+            }
         }
-        auto fanout_inst_output_pin = handler.outputPins(fanout_inst)[0];
-        auto fanout_net             = handler.net(fanout_inst_output_pin);
-        auto is_const               = isTiedToConstant(psn_inst, pin, is_tiehi);
-
-        if (is_const >= 0)
+        int  free_count  = free_inputs.size();
+        int  completions = 1 << free_count;
+        bool is_constant = true;
+        int  first_val   = truth_table[fixed_vals];
+        follows.assign(free_count, true);
+        inverts.assign(free_count, true);
+        for (int c = 0; c < completions; c++)
         {
-            if (tiehi_cell && is_const == 1)
+            int m = fixed_vals;
+            for (int f = 0; f < free_count; f++)
             {
-                auto tiehi_net = handler.net(handler.outputPins(tiehi_cell)[0]);
-                PSN_LOG_DEBUG("{} is tied to 1.", handler.name(fanout_inst));
-                // for cell in fanout cells
-                // propagateTieHiLoCell(psn_inst, true, fanout_inst, max_depth?
-                // max_depth-1: 0, tiehi_cell, tielo_cell);
-                // Remove fanout_inst and Connect all fanouts to tiehi;
-                propagateTieHiLoCell(
-                    psn_inst, true, fanout_inst_output_pin,
-                    max_depth == -1 ? max_depth : max_depth - 1,
-                    invereter_replace, tiehi_cell, tielo_cell,
-                    inverter_lib_cell, smallest_buffer_lib_cell, tiehi_lib_cell,
-                    tielo_lib_cell, visited, deleted_inst, deleted_pins);
-                if (deleted_inst.count(fanout_inst))
-                {
-                    continue;
-                }
-                PSN_LOG_DEBUG("Removing {}/{} (constant 1)",
-                              handler.name(fanout_inst),
-                              handler.name(handler.libraryCell(fanout_inst)));
-                auto   fanout_sink_pins = handler.fanoutPins(fanout_net, true);
-                size_t toplevel_count   = 0;
-                for (auto& sink_pin : fanout_sink_pins)
-                {
-                    PSN_LOG_DEBUG("Connected {} to tielo",
-                                  handler.name(sink_pin));
-                    // There does not seem to be a way for the DB to connect two
-                    // nets So for the top-level port add tie-cell or buffer to
-                    // connect multiple nets.
-                    if (handler.isTopLevel(sink_pin))
-                    {
-                        if (tiehi_lib_cell)
-                        {
-                            auto out_tiehi_inst = handler.createInstance(
-                                std::string("tiehi_output_" +
-                                            handler.name(sink_pin))
-                                    .c_str(),
-                                tiehi_lib_cell);
-
-                            auto out_tiehi_out_pin =
-                                handler.outputPins(out_tiehi_inst)[0];
-                            auto sink_net = handler.net(handler.term(sink_pin));
-
-                            handler.connect(sink_net, out_tiehi_out_pin);
-                        }
-                        else
-                        {
-                            auto out_buff_inst = handler.createInstance(
-                                std::string("buf_output_" +
-                                            handler.name(sink_pin))
-                                    .c_str(),
-                                smallest_buffer_lib_cell);
-
-                            auto out_buff_out_pin =
-                                handler.outputPins(out_buff_inst)[0];
-                            auto out_buff_in_pin =
-                                handler.inputPins(out_buff_inst)[0];
-                            auto sink_net = handler.net(handler.term(sink_pin));
-
-                            handler.connect(sink_net, out_buff_out_pin);
-                            handler.connect(tiehi_net, out_buff_in_pin);
-                        }
-                        toplevel_count++;
-                    }
-                    else
-                    {
-                        handler.disconnect(sink_pin);
-                        handler.connect(tiehi_net, sink_pin);
-                    }
-                }
-
-                assert(handler.fanoutPins(fanout_net, true).size() ==
-                       toplevel_count);
-                handler.del(fanout_inst);
-                deleted_inst.insert(fanout_inst);
-                deleted_pins.insert(fanout_inst_output_pin);
-                for (auto& p : fanout_inst_input_pins)
+                if ((c >> f) & 1)
                 {
-                    deleted_pins.insert(p);
+                    m |= 1 << free_inputs[f];
                 }
-                prop_count_++;
             }
-            else if (tielo_cell && is_const == 0)
+            int val = truth_table[m];
+            if (val != first_val)
             {
-                auto tielo_net = handler.net(handler.outputPins(tielo_cell)[0]);
-                PSN_LOG_DEBUG("{} is tied to 0.", handler.name(fanout_inst));
-                // for cell in fanout cells
-                // propagateTieHiLoCell(psn_inst, false, fanout_inst, max_depth?
-                // max_depth-1: 0, tiehi_cell, tielo_cell); Remove fanout_inst
-                // and Connect all fanouts to tiehi; Remove fanout_inst and
-                // Connect all fanouts to tielo;
-
-                propagateTieHiLoCell(
-                    psn_inst, false, fanout_inst_output_pin,
-                    max_depth == -1 ? max_depth : max_depth - 1,
-                    invereter_replace, tiehi_cell, tielo_cell,
-                    inverter_lib_cell, smallest_buffer_lib_cell, tiehi_lib_cell,
-                    tielo_lib_cell, visited, deleted_inst, deleted_pins);
-
-                if (deleted_inst.count(fanout_inst))
-                {
-
-                    continue;
-                }
-
-                auto fanout_sink_pins = handler.fanoutPins(fanout_net, true);
-                PSN_LOG_DEBUG("Removing {}/{} (constant 0)",
-                              handler.name(fanout_inst),
-                              handler.name(handler.libraryCell(fanout_inst)));
-                size_t toplevel_count = 0;
-                for (auto& sink_pin : fanout_sink_pins)
+                is_constant = false;
+            }
+            for (int f = 0; f < free_count; f++)
+            {
+                int bit = (c >> f) & 1;
+                if (val != bit)
                 {
-                    PSN_LOG_DEBUG("Connected {} to tielo",
-                                  handler.name(sink_pin));
-
-                    // There does not seem to be a way for the DB to connect two
-                    // nets So for the top-level port add tie-cell or buffer to
-                    // connect multiple nets.
-                    if (handler.isTopLevel(sink_pin))
-                    {
-                        if (tielo_lib_cell)
-                        {
-                            auto out_tielo_inst = handler.createInstance(
-                                std::string("tielo_output_" +
-                                            handler.name(sink_pin))
-                                    .c_str(),
-                                tielo_lib_cell);
-
-                            auto out_tielo_out_pin =
-                                handler.outputPins(out_tielo_inst)[0];
-                            auto sink_net = handler.net(handler.term(sink_pin));
-
-                            handler.connect(sink_net, out_tielo_out_pin);
-                        }
-                        else
-                        {
-                            auto out_buff_inst = handler.createInstance(
-                                std::string("buf_output_" +
-                                            handler.name(sink_pin))
-                                    .c_str(),
-                                smallest_buffer_lib_cell);
-
-                            auto out_buff_out_pin =
-                                handler.outputPins(out_buff_inst)[0];
-                            auto out_buff_in_pin =
-                                handler.inputPins(out_buff_inst)[0];
-                            auto sink_net = handler.net(handler.term(sink_pin));
-
-                            handler.connect(sink_net, out_buff_out_pin);
-                            handler.connect(tielo_net, out_buff_in_pin);
-                        }
-                        toplevel_count++;
-                    }
-                    else
-                    {
-                        handler.disconnect(sink_pin);
-                        handler.connect(tielo_net, sink_pin);
-                    }
+                    follows[f] = false;
                 }
-
-                assert(handler.fanoutPins(fanout_net, true).size() ==
-                       toplevel_count);
-                handler.del(fanout_inst);
-                deleted_inst.insert(fanout_inst);
-                deleted_pins.insert(fanout_inst_output_pin);
-                for (auto& p : fanout_inst_input_pins)
+                else
                 {
-                    deleted_pins.insert(p);
+                    inverts[f] = false;
                 }
-                prop_count_++;
             }
         }
-        else if (fanout_inst_input_pins.size() == 2)
+        int result = cofactor_unknown;
+        if (is_constant)
         {
-            InstanceTerm* other_pin = nullptr;
-            for (auto& p : fanout_inst_input_pins)
+            result = first_val;
+        }
+        else
+        {
+            for (int f = 0; f < free_count; f++)
             {
-                if (p != pin)
+                if (follows[f])
                 {
-                    other_pin = p;
+                    result = cofactor_tied_input + 2 * free_inputs[f];
                     break;
                 }
-            }
-            if (other_pin)
-            {
-                int is_tied_to_input =
-                    isTiedToInput(psn_inst, other_pin, pin, is_tiehi);
-                if (is_tied_to_input == 1)
+                else if (inverts[f])
                 {
-                    auto fanout_sink_pins =
-                        handler.fanoutPins(fanout_net, true);
-                    PSN_LOG_DEBUG(
-                        "{} is tied to input {}/{}. Constant pin: {}",
-                        handler.name(fanout_inst),
-                        handler.name(handler.libraryCell(fanout_inst)),
-                        handler.name(other_pin), handler.name(pin));
-                    auto other_pin_net = handler.net(other_pin);
-                    for (auto& sink_pin : fanout_sink_pins)
-                    {
-                        PSN_LOG_DEBUG("Connect {} to driver of {} [{}]",
-                                      handler.name(sink_pin),
-                                      handler.name(other_pin),
-                                      handler.name(other_pin_net));
-                        handler.disconnect(sink_pin);
-                        handler.connect(other_pin_net, sink_pin);
-                    }
-                    assert(handler.fanoutPins(fanout_net, true).size() == 0);
-                    PSN_LOG_DEBUG("Removing {} (constant input)",
-                                  handler.name(fanout_inst));
-                    handler.del(fanout_inst);
-                    deleted_inst.insert(fanout_inst);
-                    deleted_pins.insert(fanout_inst_output_pin);
-                    for (auto& p : fanout_inst_input_pins)
-                    {
-                        deleted_pins.insert(p);
-                    }
-                    prop_count_++;
+                    result = cofactor_tied_input + 2 * free_inputs[f] + 1;
+                    break;
                 }
-                else if (invereter_replace && inverter_lib_cell &&
-                         is_tied_to_input == -1)
-                {
-                    auto fanout_sink_pins =
-                        handler.fanoutPins(fanout_net, true);
+            }
+        }
+        table.results[a] = result;
+    }
+    table.valid = true;
+}
 
-                    auto other_pin_net = handler.net(other_pin);
-                    auto inst_name     = handler.name(fanout_inst);
-                    auto inv_name      = inst_name + "_folded_inverter";
-                    auto out_net_name  = inst_name + "_folder_inverter_out";
-                    auto new_inverter  = handler.createInstance(
-                        inv_name.c_str(), inverter_lib_cell);
-                    auto inverter_input_pin =
-                        handler.libraryInputPins(inverter_lib_cell)[0];
-                    auto inverter_output_pin =
-                        handler.libraryOutputPins(inverter_lib_cell)[0];
-                    auto inverter_output_net =
-                        handler.createNet(out_net_name.c_str());
-                    handler.disconnect(other_pin);
-                    handler.connect(other_pin_net, new_inverter,
-                                    inverter_input_pin);
-                    handler.connect(inverter_output_net, new_inverter,
-                                    inverter_output_pin);
-                    for (auto& sink_pin : fanout_sink_pins)
-                    {
-                        PSN_LOG_DEBUG("Connect {} to driver of {} [{}]",
-                                      handler.name(sink_pin),
-                                      handler.name(other_pin),
-                                      handler.name(other_pin_net));
-                        handler.disconnect(sink_pin);
-                        handler.connect(inverter_output_net, sink_pin);
-                    }
-                    assert(handler.fanoutPins(fanout_net, true).size() == 0);
+const ConstantPropagationTransform::CofactorTable&
+ConstantPropagationTransform::cofactorTable(Psn* psn_inst, LibraryCell* cell)
+{
+    auto itr = cofactor_tables_.find(cell);
+    if (itr != cofactor_tables_.end())
+    {
+        return itr->second;
+    }
+    CofactorTable& table = cofactor_tables_[cell];
+    buildCofactorTable(psn_inst, cell, table);
+    return table;
+}
 
-                    handler.del(fanout_inst);
-                    deleted_inst.insert(fanout_inst);
-                    deleted_pins.insert(fanout_inst_output_pin);
-                    for (auto& p : fanout_inst_input_pins)
-                    {
-                        deleted_pins.insert(p);
-                    }
-                    prop_count_++;
-                }
-            }
+Net*
+ConstantPropagationTransform::tieNet(Psn* psn_inst, Instance*& tie_inst,
+                                     LibraryCell*       tie_lib_cell,
+                                     const std::string& prefix)
+{
+    DatabaseHandler& handler = *(psn_inst->handler());
+    if (!tie_inst)
+    {
+        if (!tie_lib_cell)
+        {
+            return nullptr;
         }
+        int index = 0;
+        tie_inst  = handler.createInstance(
+            handler.generateInstanceName(prefix, index).c_str(), tie_lib_cell);
+    }
+    auto tie_pin = handler.outputPins(tie_inst)[0];
+    auto tie_net = handler.net(tie_pin);
+    if (!tie_net)
+    {
+        int index = 0;
+        tie_net   = handler.createNet(handler.generateNetName(index).c_str());
+        handler.connect(tie_net, tie_pin);
+    }
+    return tie_net;
+}
+
+void
+ConstantPropagationTransform::applyConstant(
+    Psn* psn_inst, Instance* inst, Net* constant_net, LibraryCell* tie_lib_cell,
+    LibraryCell* smallest_buffer_lib_cell, bool is_tiehi)
+{
+    DatabaseHandler& handler = *(psn_inst->handler());
+    auto             out_net = handler.net(handler.outputPins(inst)[0]);
+    PSN_LOG_DEBUG("Removing {}/{} (constant {})", handler.name(inst),
+                  handler.name(handler.libraryCell(inst)), is_tiehi ? 1 : 0);
+    if (!out_net)
+    {
+        return;
+    }
+    InstanceTerm* top_level_pin = nullptr;
+    for (auto& sink_pin : handler.fanoutPins(out_net, true))
+    {
+        if (handler.isTopLevel(sink_pin))
+        {
+            top_level_pin = sink_pin;
+        }
+        else
+        {
+            handler.disconnect(sink_pin);
+            handler.connect(constant_net, sink_pin);
+        }
+    }
+    // There does not seem to be a way for the DB to connect two nets So for
+    // the top-level ports keep the output net and drive it with a new tie-cell
+    // or a buffer.
+    if (top_level_pin)
+    {
+        std::string port_name = handler.name(top_level_pin);
+        if (tie_lib_cell)
+        {
+            auto out_tie_inst = handler.createInstance(
+                std::string((is_tiehi ? "tiehi_output_" : "tielo_output_") +
+                            port_name)
+                    .c_str(),
+                tie_lib_cell);
+            handler.disconnect(handler.outputPins(inst)[0]);
+            handler.connect(out_net, handler.outputPins(out_tie_inst)[0]);
+        }
+        else
+        {
+            auto out_buff_inst = handler.createInstance(
+                std::string("buf_output_" + port_name).c_str(),
+                smallest_buffer_lib_cell);
+            handler.disconnect(handler.outputPins(inst)[0]);
+            handler.connect(out_net, handler.outputPins(out_buff_inst)[0]);
+            handler.connect(constant_net, handler.inputPins(out_buff_inst)[0]);
+        }
+    }
+}
+
+void
+ConstantPropagationTransform::applyInputTie(
+    Psn* psn_inst, Instance* inst, LibraryTerm* input_term, bool inverted,
+    LibraryCell* inverter_lib_cell, LibraryCell* smallest_buffer_lib_cell)
+{
+    DatabaseHandler& handler   = *(psn_inst->handler());
+    auto             out_pin   = handler.outputPins(inst)[0];
+    auto             out_net   = handler.net(out_pin);
+    Net*             input_net = nullptr;
+    // Read the input net after the earlier edits so that chains of folded
+    // cells resolve to the surviving driver.
+    handler.forEachInputPin(inst, [&](InstanceTerm* pin) {
+        if (handler.libraryPin(pin) == input_term)
+        {
+            input_net = handler.net(pin);
+        }
+    });
+    if (!input_net || !out_net)
+    {
+        return;
+    }
+    PSN_LOG_DEBUG("{} is tied to {}input {}/{}", handler.name(inst),
+                  inverted ? "inverted " : "",
+                  handler.name(handler.libraryCell(inst)),
+                  handler.name(input_term));
+    if (inverted)
+    {
+        // The inverter takes over the output net, so no sink is moved.
+        auto inst_name    = handler.name(inst);
+        auto new_inverter = handler.createInstance(
+            std::string(inst_name + "_folded_inverter").c_str(),
+            inverter_lib_cell);
+        handler.disconnect(out_pin);
+        handler.connect(input_net, new_inverter,
+                        handler.libraryInputPins(inverter_lib_cell)[0]);
+        handler.connect(out_net, new_inverter,
+                        handler.libraryOutputPins(inverter_lib_cell)[0]);
+        return;
+    }
+    InstanceTerm* top_level_pin = nullptr;
+    for (auto& sink_pin : handler.fanoutPins(out_net, true))
+    {
+        if (handler.isTopLevel(sink_pin))
+        {
+            top_level_pin = sink_pin;
+        }
+        else
+        {
+            handler.disconnect(sink_pin);
+            handler.connect(input_net, sink_pin);
+        }
+    }
+    if (top_level_pin)
+    {
+        auto out_buff_inst = handler.createInstance(
+            std::string("buf_output_" + handler.name(top_level_pin)).c_str(),
+            smallest_buffer_lib_cell);
+        handler.disconnect(out_pin);
+        handler.connect(out_net, handler.outputPins(out_buff_inst)[0]);
+        handler.connect(input_net, handler.inputPins(out_buff_inst)[0]);
     }
 }
 
@@ -527,87 +411,165 @@ ConstantPropagationTransform::propagateConstants(
     {
         tielo_cell = *(tielo_cells.begin());
     }
+    if (max_depth == 0)
+    {
+        return 0;
+    }
 
-    Instance* first_tihi = nullptr;
-    Instance* first_tilo = nullptr;
+    // Level order of the combinational instances; every instance is evaluated
+    // once, after all of its drivers have settled.
+    std::unordered_map<Instance*, int> level_order;
+    for (auto& driver : handler.levelDriverPins())
+    {
+        auto inst = handler.instance(driver);
+        if (inst && !handler.isTopLevel(driver) && !level_order.count(inst))
+        {
+            int order         = level_order.size();
+            level_order[inst] = order;
+        }
+    }
+
+    std::unordered_map<Net*, int>         net_value;
+    std::unordered_map<Net*, int>         net_depth;
+    std::set<std::pair<int, Instance*>>   worklist;
+    std::vector<std::pair<Instance*, int>> edits;
+    Instance*                              first_tihi = nullptr;
+    Instance*                              first_tilo = nullptr;
+
+    auto schedule_fanout = [&](Net* net) {
+        handler.forEachFanoutPin(net, [&](InstanceTerm* pin) {
+            auto fanout_inst = handler.instance(pin);
+            auto order_itr   = level_order.find(fanout_inst);
+            if (order_itr != level_order.end())
+            {
+                worklist.insert(std::make_pair(order_itr->second, fanout_inst));
+            }
+        });
+    };
 
     for (auto instance : handler.instances())
     {
         auto instance_lib_cell = handler.libraryCell(instance);
-        if (tiehi_cells.count(instance_lib_cell))
+        bool is_tiehi          = tiehi_cells.count(instance_lib_cell);
+        if (!is_tiehi && !tielo_cells.count(instance_lib_cell))
+        {
+            continue;
+        }
+        PSN_LOG_DEBUG("Tie-{} Instance {}", is_tiehi ? "Hi" : "Lo",
+                      handler.name(instance));
+        if (is_tiehi && !first_tihi)
         {
             first_tihi = instance;
-            if (first_tilo)
-            {
-                break;
-            }
         }
-        else if (tielo_cells.count(instance_lib_cell))
+        else if (!is_tiehi && !first_tilo)
         {
             first_tilo = instance;
-            if (first_tihi)
-            {
-                break;
-            }
+        }
+        auto tie_net = handler.net(handler.outputPins(instance)[0]);
+        if (tie_net)
+        {
+            net_value[tie_net] = is_tiehi;
+            net_depth[tie_net] = 0;
+            schedule_fanout(tie_net);
         }
     }
-    const int iteration_count = 1;
-    for (int i = 0; i < iteration_count; ++i)
+
+    static const int power3[max_cofactor_inputs + 1] = {1,  3,   9,  27,
+                                                         81, 243, 729};
+    std::unordered_set<Instance*> evaluated;
+    while (!worklist.empty())
     {
-        PSN_LOG_DEBUG("Constant Propagation Iteration {}/{}", i + 1,
-                      iteration_count);
-        std::unordered_set<Instance*>     visited;
-        std::unordered_set<Instance*>     deleted_insts;
-        std::unordered_set<InstanceTerm*> deleted_pins;
-        auto                              instances = handler.instances();
-        for (auto instance : instances)
+        auto inst = worklist.begin()->second;
+        worklist.erase(worklist.begin());
+        if (evaluated.count(inst) || handler.dontTouch(inst))
         {
-            if (deleted_insts.count(instance))
+            continue;
+        }
+        evaluated.insert(inst);
+        auto& table = cofactorTable(psn_inst, handler.libraryCell(inst));
+        if (!table.valid)
+        {
+            continue;
+        }
+        int index = 0;
+        int depth = 0;
+        handler.forEachInputPin(inst, [&](InstanceTerm* pin) {
+            auto index_itr = table.input_index.find(handler.libraryPin(pin));
+            if (index_itr == table.input_index.end())
             {
-                continue;
+                return;
             }
-            auto instance_lib_cell = handler.libraryCell(instance);
-            if (tiehi_cells.count(instance_lib_cell))
+            int  val       = cofactor_x;
+            auto net       = handler.net(pin);
+            auto value_itr = net ? net_value.find(net) : net_value.end();
+            if (value_itr != net_value.end())
             {
-                auto output_pin = handler.outputPins(instance)[0];
-                PSN_LOG_DEBUG("Tie-Hi Instance {}", handler.name(instance));
-                propagateTieHiLoCell(
-                    psn_inst, true, output_pin, max_depth, invereter_replace,
-                    instance, first_tilo, inverter_lib_cell,
-                    smallest_buffer_lib_cell, tiehi_cell, tielo_cell, visited,
-                    deleted_insts, deleted_pins);
-                auto out_pins = handler.outputPins(instance, true);
-                if (out_pins.size() == 0)
-                {
-                    handler.del(instance);
-                    deleted_insts.insert(instance);
-                    for (auto& p : out_pins)
-                    {
-                        deleted_pins.insert(p);
-                    }
-                }
+                val   = value_itr->second;
+                depth = std::max(depth, net_depth[net]);
             }
-            else if (tielo_cells.count(instance_lib_cell))
+            index += val * power3[index_itr->second];
+        });
+        depth++;
+        int result = table.results[index];
+        if (result == cofactor_unknown ||
+            (max_depth != -1 && depth > max_depth))
+        {
+            continue;
+        }
+        if (result >= cofactor_tied_input && (result & 1) &&
+            (!invereter_replace || !inverter_lib_cell))
+        {
+            continue;
+        }
+        edits.push_back(std::make_pair(inst, result));
+        if (result < cofactor_tied_input)
+        {
+            auto out_net = handler.net(handler.outputPins(inst)[0]);
+            if (out_net)
             {
-                auto output_pin = handler.outputPins(instance)[0];
-                PSN_LOG_DEBUG("Tie-Lo Instance {}", handler.name(instance));
-                propagateTieHiLoCell(
-                    psn_inst, false, output_pin, max_depth, invereter_replace,
-                    first_tihi, instance, inverter_lib_cell,
-                    smallest_buffer_lib_cell, tiehi_cell, tielo_cell, visited,
-                    deleted_insts, deleted_pins);
-                auto out_pins = handler.outputPins(instance, true);
-                if (out_pins.size() == 0)
-                {
-                    handler.del(instance);
-                    deleted_insts.insert(instance);
-                    for (auto& p : out_pins)
-                    {
-                        deleted_pins.insert(p);
-                    }
-                }
+                net_value[out_net] = result;
+                net_depth[out_net] = depth;
+                schedule_fanout(out_net);
+            }
+        }
+    }
+
+    // Apply all the edits in level order once the fixed point is reached.
+    std::vector<Instance*> removed;
+    removed.reserve(edits.size());
+    for (auto& edit : edits)
+    {
+        auto inst   = edit.first;
+        int  result = edit.second;
+        if (result < cofactor_tied_input)
+        {
+            bool is_tiehi     = result == 1;
+            auto constant_net = is_tiehi
+                                    ? tieNet(psn_inst, first_tihi, tiehi_cell,
+                                             "tiehi_")
+                                    : tieNet(psn_inst, first_tilo, tielo_cell,
+                                             "tielo_");
+            if (!constant_net)
+            {
+                continue;
             }
+            applyConstant(psn_inst, inst, constant_net,
+                          is_tiehi ? tiehi_cell : tielo_cell,
+                          smallest_buffer_lib_cell, is_tiehi);
+        }
+        else
+        {
+            auto& table = cofactorTable(psn_inst, handler.libraryCell(inst));
+            int   input = (result - cofactor_tied_input) / 2;
+            applyInputTie(psn_inst, inst, table.inputs[input], result & 1,
+                          inverter_lib_cell, smallest_buffer_lib_cell);
         }
+        removed.push_back(inst);
+    }
+    for (auto inst : removed)
+    {
+        handler.del(inst);
+        prop_count_++;
     }
 
     return prop_count_;
@@ -663,6 +625,7 @@ ConstantPropagationTransform::run(Psn* psn_inst, std::vector<std::string> args)
         inverter_cell_name = args[4];
     }
     prop_count_ = 0;
+    cofactor_tables_.clear();
 
     return propagateConstants(psn_inst, tiehi_cell_name, tielo_cell_name,
                               inverter_cell_name, max_depth, invereter_replace);
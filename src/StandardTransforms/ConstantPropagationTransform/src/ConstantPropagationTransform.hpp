@@ -31,6 +31,7 @@
 
 #include <cstring>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include "OpenPhySyn/Database/DatabaseHandler.hpp"
 #include "OpenPhySyn/Database/Types.hpp"
@@ -43,25 +44,36 @@ namespace psn
 class ConstantPropagationTransform : public PsnTransform
 {
 private:
+    // Output of a single-output combinational cell for every assignment of
+    // its inputs to {0, 1, X}, indexed by the base-3 encoding of the
+    // assignment (input i contributes value * 3^i, X is encoded as 2).
+    struct CofactorTable
+    {
+        bool                                  valid;
+        std::vector<LibraryTerm*>             inputs;
+        std::unordered_map<LibraryTerm*, int> input_index;
+        std::vector<int>                      results;
+    };
+
     bool isNumber(const std::string& s);
     int  prop_count_;
+    std::unordered_map<LibraryCell*, CofactorTable> cofactor_tables_;
 
-    int  propagateConstants(Psn* psn_inst, std::string tiehi_cell_name,
-                            std::string tielo_cell_name,
-                            std::string inverter_cell_name, int max_depth,
-                            bool invereter_replace);
-    void propagateTieHiLoCell(
-        Psn* psn_inst, bool is_tiehi, InstanceTerm* constant_term,
-        int max_depth, bool invereter_replace, Instance* tiehi_cell,
-        Instance* tielo_cell, LibraryCell* inverter_lib_cell,
-        LibraryCell* smallest_buffer_lib_cell, LibraryCell* tiehi_lib_cell,
-        LibraryCell* tielo_lib_cell, std::unordered_set<Instance*>& visited,
-        std::unordered_set<Instance*>&     deleted_inst,
-        std::unordered_set<InstanceTerm*>& deleted_pins);
-    int isTiedToConstant(Psn* psn_inst, InstanceTerm* constant_term,
-                         bool constant_val);
-    int isTiedToInput(Psn* psn_inst, InstanceTerm* input_term,
-                      InstanceTerm* constant_term, bool constant_val);
+    int propagateConstants(Psn* psn_inst, std::string tiehi_cell_name,
+                           std::string tielo_cell_name,
+                           std::string inverter_cell_name, int max_depth,
+                           bool invereter_replace);
+    const CofactorTable& cofactorTable(Psn* psn_inst, LibraryCell* cell);
+    void buildCofactorTable(Psn* psn_inst, LibraryCell* cell,
+                            CofactorTable& table);
+    void applyConstant(Psn* psn_inst, Instance* inst, Net* constant_net,
+                       LibraryCell* tie_lib_cell,
+                       LibraryCell* smallest_buffer_lib_cell, bool is_tiehi);
+    void applyInputTie(Psn* psn_inst, Instance* inst, LibraryTerm* input_term,
+                       bool inverted, LibraryCell* inverter_lib_cell,
+                       LibraryCell* smallest_buffer_lib_cell);
+    Net* tieNet(Psn* psn_inst, Instance*& tie_inst, LibraryCell* tie_lib_cell,
+                const std::string& prefix);
 
 public:
     ConstantPropagationTransform();
@@ -34,6 +34,7 @@
 #include <cmath>
 #include <limits>
 #include <sstream>
+#include <thread>
 #include "OpenPhySyn/PsnLogger/PsnLogger.hpp"
 #include "OpenPhySyn/Sta/DatabaseStaNetwork.hpp"
 #include "OpenPhySyn/Utils/PsnGlobal.hpp"
@@ -54,54 +55,101 @@ GateCloningTransform::gateClone(Psn* psn_inst, float cap_factor,
 {
     clone_count_             = 0;
     DatabaseHandler& handler = *(psn_inst->handler());
+    float            cap_per_micron = handler.capacitancePerMicron();
     PSN_LOG_DEBUG("Clone {} {}", cap_factor, clone_largest_only);
+    budget_.start(clone_count_);
     std::vector<InstanceTerm*> level_drvrs = handler.levelDriverPins(true);
+
+    // Timing queries are not thread-safe, so the candidates are selected
+    // serially.
+    std::vector<ClonePlan> plans;
     for (auto& pin : level_drvrs)
     {
         Instance* inst = handler.instance(pin);
         if (handler.isSingleOutputCombinational(inst))
         {
-            cloneTree(psn_inst, inst, cap_factor, clone_largest_only);
+            ClonePlan plan;
+            if (cloneCandidate(psn_inst, inst, cap_factor, clone_largest_only,
+                               plan))
+            {
+                plans.push_back(std::move(plan));
+            }
+        }
+    }
+
+    // Building the Steiner trees and partitioning the sinks only reads the
+    // design, so the plans are computed concurrently.
+    size_t thread_count =
+        std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                         plans.size());
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t i = t; i < plans.size(); i += thread_count)
+            {
+                planClone(psn_inst, plans[i], cap_per_micron);
+            }
+        }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Commit in the original level order; a driver whose net was changed by
+    // an earlier commit is re-evaluated against the updated design.
+    std::unordered_set<Net*> stale_nets;
+    for (size_t i = 0; i < plans.size(); i++)
+    {
+        if (budget_.exhausted(clone_count_))
+        {
+            PSN_LOG_INFO("Skipped {} clone candidates", plans.size() - i);
+            break;
+        }
+        auto& plan = plans[i];
+        if (stale_nets.count(plan.net))
+        {
+            ClonePlan replan;
+            if (!cloneCandidate(psn_inst, plan.inst, cap_factor,
+                                clone_largest_only, replan))
+            {
+                continue;
+            }
+            planClone(psn_inst, replan, cap_per_micron);
+            commitClone(psn_inst, replan, stale_nets);
+        }
+        else
+        {
+            commitClone(psn_inst, plan, stale_nets);
         }
     }
     return clone_count_;
 }
-void
-GateCloningTransform::cloneTree(Psn* psn_inst, Instance* inst, float cap_factor,
-                                bool clone_largest_only)
+bool
+GateCloningTransform::cloneCandidate(Psn* psn_inst, Instance* inst,
+                                     float cap_factor, bool clone_largest_only,
+                                     ClonePlan& plan)
 {
     DatabaseHandler& handler = *(psn_inst->handler());
-    float cap_per_micron     = psn_inst->handler()->capacitancePerMicron();
 
     auto output_pins = handler.outputPins(inst);
     if (!output_pins.size())
     {
-        return;
+        return false;
     }
     InstanceTerm* output_pin = *(output_pins.begin());
     Net*          net        = handler.net(output_pin);
     if (!net)
     {
-        return;
-    }
-    std::unique_ptr<SteinerTree> tree = SteinerTree::create(net, psn_inst);
-    if (tree == nullptr)
-    {
-        return;
+        return false;
     }
-    auto driver_lib = handler.libraryCell(inst);
-
-    float        total_net_load = tree->totalLoad(cap_per_micron);
-    LibraryCell* cell           = handler.libraryCell(inst);
-
-    float output_target_load = handler.targetLoad(cell);
-
-    float c_limit = cap_factor * output_target_load;
+    LibraryCell* cell = handler.libraryCell(inst);
 
     if (!handler.violatesMaximumTransition(output_pin) &&
         !handler.violatesMaximumCapacitance(output_pin))
     {
-        return;
+        return false;
     }
     auto  slew = handler.slew(output_pin);
     auto  cap  = handler.loadCapacitance(output_pin);
@@ -111,18 +159,9 @@ GateCloningTransform::cloneTree(Psn* psn_inst, Instance* inst, float cap_factor,
     float slew_ratio = slew / slew_limit;
     auto  cap_ratio  = cap / cap_limit;
 
-    PSN_LOG_TRACE("{} {} output_target_load: {}", handler.name(inst),
-                  handler.name(cell), output_target_load);
-    PSN_LOG_TRACE("{} {} cap_per_micron: {}", handler.name(inst),
-                  handler.name(cell), cap_per_micron);
-    PSN_LOG_TRACE("{} {} c_limit: {}", handler.name(inst), handler.name(cell),
-                  c_limit);
-    PSN_LOG_TRACE("{} {} total_net_load: {}", handler.name(inst),
-                  handler.name(cell), total_net_load);
-
     if (slew_ratio < 1.4 && cap_ratio < 1.4)
     {
-        return;
+        return false;
     }
     clone_largest_only = false;
 
@@ -130,83 +169,150 @@ GateCloningTransform::cloneTree(Psn* psn_inst, Instance* inst, float cap_factor,
     {
         PSN_LOG_TRACE("{} {} is not the largest cell", handler.name(inst),
                       handler.name(cell));
-        return;
+        return false;
+    }
+    if (handler.fanoutCount(net) <= 1)
+    {
+        return false;
     }
-    int fanout_count = handler.fanoutPins(net).size();
 
-    if (fanout_count <= 1)
+    auto half_drvr = handler.halfDrivingPowerCell(cell);
+    if (half_drvr == cell)
     {
-        return;
+        return false;
     }
 
-    auto half_drvr = handler.halfDrivingPowerCell(driver_lib);
-    if (half_drvr == driver_lib)
+    plan.inst       = inst;
+    plan.output_pin = output_pin;
+    plan.net        = net;
+    plan.clone_cell = half_drvr;
+    plan.c_limit    = cap_factor * handler.targetLoad(half_drvr);
+    // Collected here since sorting the pins by name is not thread-safe.
+    plan.pins = handler.connectedPins(net);
+    PSN_LOG_TRACE("{} {} c_limit: {}", handler.name(inst), handler.name(cell),
+                  plan.c_limit);
+    return true;
+}
+void
+GateCloningTransform::planClone(Psn* psn_inst, ClonePlan& plan,
+                                float cap_per_micron)
+{
+    plan.tree = SteinerTree::create(plan.net, plan.pins, psn_inst);
+    if (plan.tree == nullptr)
     {
         return;
     }
-
-    PSN_LOG_DEBUG("Cloning {} {}", handler.name(inst), handler.name(cell));
-    auto prec          = clone_count_;
-    output_target_load = handler.targetLoad(half_drvr);
-
-    c_limit = cap_factor * output_target_load;
-
-    topDownClone(psn_inst, tree, tree->top(), tree->driverPoint(), c_limit,
-                 half_drvr);
-    auto postc = clone_count_;
-    if (prec != postc)
+    std::unordered_map<SteinerPoint, float> loads;
+    topDownClone(psn_inst, plan, plan.tree->top(), cap_per_micron, loads);
+}
+void
+GateCloningTransform::commitClone(Psn* psn_inst, ClonePlan& plan,
+                                  std::unordered_set<Net*>& stale_nets)
+{
+    DatabaseHandler& handler = *(psn_inst->handler());
+    if (plan.tree == nullptr || !plan.subtrees.size())
+    {
+        return;
+    }
+    PSN_LOG_DEBUG("Cloning {} {}", handler.name(plan.inst),
+                  handler.name(handler.libraryCell(plan.inst)));
+    auto prec = clone_count_;
+    for (auto& subtree : plan.subtrees)
+    {
+        cloneInstance(psn_inst, plan.tree, subtree.first, subtree.second,
+                      plan.clone_cell);
+    }
+    if (prec != clone_count_)
+    {
+        handler.replaceInstance(plan.inst, plan.clone_cell);
+        // The clones and the downsized driver change the loads seen by the
+        // upstream drivers.
+        handler.forEachInputPin(plan.inst, [&](InstanceTerm* pin) {
+            auto input_net = handler.net(pin);
+            if (input_net)
+            {
+                stale_nets.insert(input_net);
+            }
+        });
+    }
+}
+float
+GateCloningTransform::subtreeLoad(Psn*                          psn_inst,
+                                  std::unique_ptr<SteinerTree>& tree,
+                                  SteinerPoint k, float cap_per_micron,
+                                  std::unordered_map<SteinerPoint, float>& loads)
+{
+    if (k == SteinerNull)
+    {
+        return 0;
+    }
+    auto itr = loads.find(k);
+    if (itr != loads.end())
+    {
+        return itr->second;
+    }
+    DatabaseHandler& handler = *(psn_inst->handler());
+    SteinerPoint     left    = tree->left(k);
+    SteinerPoint     right   = tree->right(k);
+    float            load    = 0;
+    if (left == SteinerNull && right == SteinerNull)
+    {
+        load = handler.pinCapacitance(tree->pin(k));
+    }
+    else
     {
-        handler.replaceInstance(inst, half_drvr);
+        if (left != SteinerNull)
+        {
+            load += subtreeLoad(psn_inst, tree, left, cap_per_micron, loads) +
+                    handler.dbuToMeters(tree->distance(k, left)) *
+                        cap_per_micron;
+        }
+        if (right != SteinerNull)
+        {
+            load += subtreeLoad(psn_inst, tree, right, cap_per_micron, loads) +
+                    handler.dbuToMeters(tree->distance(k, right)) *
+                        cap_per_micron;
+        }
     }
+    loads[k] = load;
+    return load;
 }
 void
-GateCloningTransform::topDownClone(Psn*                          psn_inst,
-                                   std::unique_ptr<SteinerTree>& tree,
-                                   SteinerPoint k, SteinerPoint prev,
-                                   float c_limit, LibraryCell* driver_cell)
+GateCloningTransform::topDownClone(
+    Psn* psn_inst, ClonePlan& plan, SteinerPoint k, float cap_per_micron,
+    std::unordered_map<SteinerPoint, float>& loads)
 {
     DatabaseHandler& handler = *(psn_inst->handler());
-    float cap_per_micron     = psn_inst->handler()->capacitancePerMicron();
+    auto&            tree    = plan.tree;
 
     SteinerPoint drvr = tree->driverPoint();
 
     float src_wire_len = handler.dbuToMeters(tree->distance(drvr, k));
     float src_wire_cap = src_wire_len * cap_per_micron;
-    if (src_wire_cap > c_limit)
+    if (src_wire_cap > plan.c_limit)
     {
         return;
     }
 
-    SteinerPoint left  = tree->left(k);
-    SteinerPoint right = tree->right(k);
-    if (left != SteinerNull)
+    SteinerPoint children[2] = {tree->left(k), tree->right(k)};
+    for (auto& child : children)
     {
-        float cap_left = tree->subtreeLoad(cap_per_micron, left) + src_wire_cap;
-        bool  is_leaf =
-            tree->left(left) == SteinerNull && tree->right(left) == SteinerNull;
-        if (cap_left < c_limit || is_leaf)
-        {
-            cloneInstance(psn_inst, tree, left, k, driver_cell);
-        }
-        else
+        if (child == SteinerNull)
         {
-            topDownClone(psn_inst, tree, left, k, c_limit, driver_cell);
+            continue;
         }
-    }
-
-    if (right != SteinerNull)
-    {
-        float cap_right =
-            tree->subtreeLoad(cap_per_micron, right) + src_wire_cap;
-        bool is_leaf = tree->left(right) == SteinerNull &&
-                       tree->right(right) == SteinerNull;
-        if (cap_right < c_limit || is_leaf)
+        float child_cap =
+            subtreeLoad(psn_inst, tree, child, cap_per_micron, loads) +
+            src_wire_cap;
+        bool is_leaf =
+            tree->left(child) == SteinerNull && tree->right(child) == SteinerNull;
+        if (child_cap < plan.c_limit || is_leaf)
         {
-            cloneInstance(psn_inst, tree, right, k, driver_cell);
+            plan.subtrees.push_back(std::make_pair(child, k));
         }
         else
         {
-            topDownClone(psn_inst, tree, right, k, c_limit, driver_cell);
+            topDownClone(psn_inst, plan, child, cap_per_micron, loads);
         }
     }
 }
@@ -371,6 +477,33 @@ GateCloningTransform::cloneInstance(Psn*                          psn_inst,
 int
 GateCloningTransform::run(Psn* psn_inst, std::vector<std::string> args)
 {
+    budget_ = OptimizationBudget();
+    std::vector<std::string> positional_args;
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        if (args[i] == "-time_budget" || args[i] == "-max_edits")
+        {
+            if (i + 1 >= args.size() || !StringUtils::isNumber(args[i + 1]))
+            {
+                PSN_LOG_ERROR(help());
+                return -1;
+            }
+            if (args[i] == "-time_budget")
+            {
+                budget_.setTimeBudget(std::stof(args[i + 1]));
+            }
+            else
+            {
+                budget_.setMaxEdits(std::stoi(args[i + 1]));
+            }
+            i++;
+        }
+        else
+        {
+            positional_args.push_back(args[i]);
+        }
+    }
+    args = positional_args;
     if (args.size() > 2)
     {
         PSN_LOG_ERROR(help());
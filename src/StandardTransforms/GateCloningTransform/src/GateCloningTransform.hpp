@@ -31,30 +31,56 @@
 
 #include <cstring>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "OpenPhySyn/Database/DatabaseHandler.hpp"
 #include "OpenPhySyn/Database/Types.hpp"
 #include "OpenPhySyn/Optimize/SteinerTree.hpp"
 #include "OpenPhySyn/Psn/Psn.hpp"
 #include "OpenPhySyn/Transform/PsnTransform.hpp"
+#include "OpenPhySyn/Utils/OptimizationBudget.hpp"
 
 namespace psn
 {
 class GateCloningTransform : public PsnTransform
 {
 private:
-    void cloneTree(Psn* psn_inst, Instance* inst, float cap_factor,
-                   bool clone_largest_only);
-    void topDownClone(Psn* psn_inst, std::unique_ptr<SteinerTree>& tree,
-                      SteinerPoint k, SteinerPoint prev, float c_limit,
-                      LibraryCell* driver_cell);
-    void topDownConnect(Psn* psn_inst, std::unique_ptr<SteinerTree>& tree,
-                        SteinerPoint k, Net* net);
-    void cloneInstance(Psn* psn_inst, std::unique_ptr<SteinerTree>& tree,
-                       SteinerPoint k, SteinerPoint prev,
-                       LibraryCell* driver_cell);
-    int  net_index_;
-    int  clone_index_;
-    int  clone_count_;
+    // Clone decision for one driver, computed without touching the design
+    // so that plans for all drivers can be built concurrently. Each entry of
+    // subtrees is a (subtree root, parent) pair to be moved to a new clone.
+    struct ClonePlan
+    {
+        Instance*                                          inst;
+        InstanceTerm*                                      output_pin;
+        Net*                                               net;
+        LibraryCell*                                       clone_cell;
+        float                                              c_limit;
+        std::vector<InstanceTerm*>                         pins;
+        std::unique_ptr<SteinerTree>                       tree;
+        std::vector<std::pair<SteinerPoint, SteinerPoint>> subtrees;
+    };
+
+    bool  cloneCandidate(Psn* psn_inst, Instance* inst, float cap_factor,
+                         bool clone_largest_only, ClonePlan& plan);
+    void  planClone(Psn* psn_inst, ClonePlan& plan, float cap_per_micron);
+    void  commitClone(Psn* psn_inst, ClonePlan& plan,
+                      std::unordered_set<Net*>& stale_nets);
+    void  topDownClone(Psn* psn_inst, ClonePlan& plan, SteinerPoint k,
+                       float cap_per_micron,
+                       std::unordered_map<SteinerPoint, float>& loads);
+    float subtreeLoad(Psn* psn_inst, std::unique_ptr<SteinerTree>& tree,
+                      SteinerPoint k, float cap_per_micron,
+                      std::unordered_map<SteinerPoint, float>& loads);
+    void  topDownConnect(Psn* psn_inst, std::unique_ptr<SteinerTree>& tree,
+                         SteinerPoint k, Net* net);
+    void  cloneInstance(Psn* psn_inst, std::unique_ptr<SteinerTree>& tree,
+                        SteinerPoint k, SteinerPoint prev,
+                        LibraryCell* driver_cell);
+    int   net_index_;
+    int   clone_index_;
+    int   clone_count_;
+
+    OptimizationBudget budget_;
 
 public:
     GateCloningTransform();
@@ -66,6 +92,7 @@ public:
 DEFINE_TRANSFORM(GateCloningTransform, "gate_clone", "1.0",
                  "Performs load-driven gate cloning",
                  "Usage: transform gate_clone "
-                 "<float: max-cap-factor> <boolean: clone-gates-only>")
+                 "<float: max-cap-factor> <boolean: clone-gates-only> "
+                 "[-time_budget <seconds>] [-max_edits <num_edits>]")
 
 } // namespace psn
\ No newline at end of file
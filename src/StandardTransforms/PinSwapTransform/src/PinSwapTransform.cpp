@@ -42,6 +42,8 @@
 #include <cmath>
 #include <limits>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace psn
 {
@@ -103,6 +105,198 @@ PinSwapTransform::powerPinSwap(psn::Psn* psn_inst, int path_count)
 
     return swap_count_;
 }
+
+int
+PinSwapTransform::activityPinSwap(psn::Psn* psn_inst)
+{
+    DatabaseHandler& handler = *(psn_inst->handler());
+
+    // Computing the design power propagates the switching activities used to
+    // rank the candidates below. The per-instance power cache is used so the
+    // total after the swaps only re-evaluates the cells on the swapped nets.
+    float power_before = handler.cachedPower();
+
+    // For a commutative pair (a, b) the switched input capacitance is
+    // act(a) * cap(a) + act(b) * cap(b); swapping the nets changes it by
+    // -(act(a) - act(b)) * (cap(a) - cap(b)), so no timing update is needed
+    // to evaluate a swap.
+    std::vector<SwapCandidate> candidates;
+    std::vector<InstanceTerm*> candidate_pins;
+    for (auto& inst : handler.instances())
+    {
+        if (handler.dontTouch(inst) || !handler.isCombinational(inst))
+        {
+            continue;
+        }
+        auto input_pins = handler.inputPins(inst);
+        if (input_pins.size() < 2 || handler.outputPins(inst).size() != 1)
+        {
+            continue;
+        }
+        std::vector<float> activities(input_pins.size());
+        std::vector<float> caps(input_pins.size());
+        for (size_t i = 0; i < input_pins.size(); i++)
+        {
+            activities[i] = handler.activity(input_pins[i]);
+            caps[i]       = handler.pinCapacitance(input_pins[i]);
+        }
+        for (size_t i = 0; i < input_pins.size(); i++)
+        {
+            for (size_t j = i + 1; j < input_pins.size(); j++)
+            {
+                float gain =
+                    (activities[i] - activities[j]) * (caps[i] - caps[j]);
+                if (gain <= 0.0 ||
+                    !handler.isCommutative(input_pins[i], input_pins[j]))
+                {
+                    continue;
+                }
+                candidates.push_back({gain, input_pins[i], input_pins[j]});
+                candidate_pins.push_back(input_pins[i]);
+                candidate_pins.push_back(input_pins[j]);
+            }
+        }
+    }
+    if (!candidates.size())
+    {
+        PSN_LOG_INFO("No power reducing pin swaps found");
+        return 0;
+    }
+
+    // Swapping pins on a failing path might worsen it further, so those pins
+    // are kept in place.
+    auto slacks = handler.worstSlacks(candidate_pins);
+    std::unordered_map<InstanceTerm*, float> pin_slack;
+    for (size_t i = 0; i < candidate_pins.size(); i++)
+    {
+        pin_slack[candidate_pins[i]] = slacks[i];
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const SwapCandidate& a, const SwapCandidate& b) {
+                         return a.gain > b.gain;
+                     });
+
+    // Greedily accept the best non-overlapping pairs and apply them as one
+    // batch, updating the parasitics of each affected net once.
+    // Each swap moves a pin capacitance from one input net to the other, so
+    // besides the cell output the drivers of both input nets are checked.
+    std::unordered_set<InstanceTerm*> swapped_pins;
+    std::vector<SwapCandidate>        accepted;
+    std::vector<InstanceTerm*>        checked_pins;
+    std::vector<size_t>               checked_begin;
+    for (auto& candidate : candidates)
+    {
+        if (swapped_pins.count(candidate.first) ||
+            swapped_pins.count(candidate.second) ||
+            pin_slack[candidate.first] < 0.0 ||
+            pin_slack[candidate.second] < 0.0)
+        {
+            continue;
+        }
+        swapped_pins.insert(candidate.first);
+        swapped_pins.insert(candidate.second);
+        accepted.push_back(candidate);
+        checked_begin.push_back(checked_pins.size());
+        checked_pins.push_back(
+            handler.outputPins(handler.instance(candidate.first))[0]);
+        for (auto input_pin : {candidate.first, candidate.second})
+        {
+            auto input_driver = handler.faninPin(handler.net(input_pin));
+            if (input_driver)
+            {
+                checked_pins.push_back(input_driver);
+            }
+        }
+    }
+    checked_begin.push_back(checked_pins.size());
+    auto pre_swap_slacks = handler.worstSlacks(checked_pins);
+
+    std::unordered_set<Net*> affected_nets;
+    auto                     swap_nets = [&](const SwapCandidate& candidate) {
+        auto first_net  = handler.net(candidate.first);
+        auto second_net = handler.net(candidate.second);
+        handler.disconnect(candidate.first);
+        handler.disconnect(candidate.second);
+        handler.connect(first_net, candidate.second);
+        handler.connect(second_net, candidate.first);
+        affected_nets.insert(first_net);
+        affected_nets.insert(second_net);
+    };
+    auto update_parasitics = [&]() {
+        if (handler.hasWireRC())
+        {
+            for (auto& net : affected_nets)
+            {
+                handler.calculateParasitics(net);
+            }
+        }
+        affected_nets.clear();
+    };
+    for (auto& candidate : accepted)
+    {
+        swap_nets(candidate);
+    }
+    update_parasitics();
+
+    // The pin capacitances differ, so a swap also changes the gate delays;
+    // as in the timing-driven swap, the ones that made a checked pin fail
+    // timing are undone.
+    auto post_swap_slacks = handler.worstSlacks(checked_pins);
+    int  undone           = 0;
+
+    std::vector<SwapCandidate> kept;
+    for (size_t i = 0; i < accepted.size(); i++)
+    {
+        bool worsened = false;
+        for (size_t j = checked_begin[i]; j < checked_begin[i + 1]; j++)
+        {
+            if (post_swap_slacks[j] < pre_swap_slacks[j] &&
+                post_swap_slacks[j] < 0.0)
+            {
+                worsened = true;
+                break;
+            }
+        }
+        if (worsened)
+        {
+            swap_nets(accepted[i]);
+            undone++;
+            continue;
+        }
+        kept.push_back(accepted[i]);
+    }
+    update_parasitics();
+    if (undone)
+    {
+        PSN_LOG_INFO("Undid {} pin swaps that violated timing", undone);
+    }
+
+    // The gain estimate ignores internal power, so the batch is only kept if
+    // the timer agrees that it saves power.
+    float power_after = handler.cachedPower();
+    if (power_after > power_before)
+    {
+        for (auto& candidate : kept)
+        {
+            swap_nets(candidate);
+        }
+        update_parasitics();
+        PSN_LOG_INFO("Undid {} pin swaps that increased power", kept.size());
+        kept.clear();
+        power_after = handler.cachedPower();
+    }
+    for (auto& candidate : kept)
+    {
+        PSN_LOG_DEBUG("Accepted Swap: {} <-> {}", handler.name(candidate.first),
+                      handler.name(candidate.second));
+        swap_count_++;
+    }
+    PSN_LOG_INFO("Swapped {} pin pairs out of {} candidates, power {} -> {}",
+                 swap_count_, candidates.size(), power_before, power_after);
+    return swap_count_;
+}
+
 int
 PinSwapTransform::timingPinSwap(psn::Psn* psn_inst, int path_count)
 {
@@ -198,6 +392,7 @@ int
 PinSwapTransform::run(Psn* psn_inst, std::vector<std::string> args)
 {
     bool power_opt     = false;
+    bool activity_opt  = false;
     int  max_opt_paths = 50;
     if (args.size() > 2 || args.size() < 1)
     {
@@ -214,6 +409,10 @@ PinSwapTransform::run(Psn* psn_inst, std::vector<std::string> args)
             {
                 power_opt = true;
             }
+            else if (arg == "-activity" || arg == "--activity")
+            {
+                activity_opt = true;
+            }
             else if (StringUtils::isNumber(arg))
             {
                 max_opt_paths = atoi(arg.c_str());
@@ -226,7 +425,11 @@ PinSwapTransform::run(Psn* psn_inst, std::vector<std::string> args)
         }
     }
     swap_count_ = 0;
-    if (power_opt)
+    if (activity_opt)
+    {
+        return activityPinSwap(psn_inst);
+    }
+    else if (power_opt)
     {
         return powerPinSwap(psn_inst, max_opt_paths);
     }
@@ -42,12 +42,22 @@ namespace psn
 class PinSwapTransform : public PsnTransform
 {
 private:
+    // A commutative input pair whose swap reduces the switched capacitance
+    // seen by the input nets; gain is the estimated activity * capacitance
+    // reduction.
+    struct SwapCandidate
+    {
+        float         gain;
+        InstanceTerm* first;
+        InstanceTerm* second;
+    };
     int swap_count_;
 
 public:
     PinSwapTransform();
     int timingPinSwap(Psn* psn_inst, int path_count);
     int powerPinSwap(Psn* psn_inst, int path_count);
+    int activityPinSwap(Psn* psn_inst);
 
     int run(Psn* psn_inst, std::vector<std::string> args) override;
 };
@@ -55,6 +65,6 @@ public:
 DEFINE_TRANSFORM(
     PinSwapTransform, "pin_swap", "1.1",
     "Performs timing-driven/power-driven commutative pin swapping optimization",
-    "Usage: transform pin_swap <max_num_optimize_paths> [-optimize_power]")
+    "Usage: transform pin_swap <max_num_optimize_paths> [-power|-activity]")
 
 } // namespace psn
\ No newline at end of file
@@ -40,9 +40,14 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <functional>
+#include <iomanip>
 #include <limits>
 #include <sstream>
+#include <thread>
 
 namespace psn
 {
@@ -58,10 +63,21 @@ RepairTimingTransform::RepairTimingTransform()
       transition_violations_(0),
       capacitance_violations_(0),
       current_area_(0.0),
-      saved_slack_(0.0)
+      saved_slack_(0.0),
+      checkpoint_frequency_(0),
+      last_checkpoint_edits_(0),
+      resume_iteration_(0),
+      resume_phase_(RepairPhase::Transition),
+      current_phase_(RepairPhase::Transition),
+      snapshot_pending_(false)
 {
 }
 
+RepairTimingTransform::~RepairTimingTransform()
+{
+    waitForSnapshot();
+}
+
 std::unordered_set<Instance*>
 RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                                  RepairTarget                          target,
@@ -93,10 +109,17 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
 
     // Create the Steiner tree
     pin_net      = handler.net(pin);
-    auto st_tree = SteinerTree::create(pin_net, psn_inst);
+    auto st_tree = plannedTree(psn_inst, pin, pin_net);
+    if (!st_tree)
+    {
+        st_tree = SteinerTree::create(pin_net, psn_inst);
+    }
     if (!st_tree)
     {
-        if (handler.connectedPins(pin_net).size() >= 2)
+        int connected_count = 0;
+        handler.forEachConnectedPin(
+            pin_net, [&](InstanceTerm*) { connected_count++; });
+        if (connected_count >= 2)
         {
             PSN_LOG_ERROR("Failed to create steiner tree for {}",
                           handler.name(pin));
@@ -145,9 +168,9 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
         std::shared_ptr<BufferTree> max_req_tree  = nullptr;
         std::shared_ptr<BufferTree> inv_buff_tree = nullptr;
         auto                        no_buff_tree  = buff_sol->bufferTrees()[0];
-        float                       old_delay =
-            handler.gateDelay(pin, no_buff_tree->totalCapacitance());
-        float old_slack = no_buff_tree->totalRequiredOrSlew() - old_delay;
+        // Slacks are taken at the corner each tree is worst in.
+        auto  driver_port = handler.libraryPin(pin);
+        float old_slack   = no_buff_tree->driverRequired(psn_inst, driver_port);
 
         auto driver_lib = handler.libraryCell(driver_cell);
         // 2. Construct minimum cost buffer tree
@@ -185,6 +208,26 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                 buff_sol->optimalDriverTree(psn_inst, pin, inv_buff_tree, 0);
         }
 
+        // A buffering is committed as a whole, so a tree that does not fit in
+        // the remaining edit budget is dropped instead of being truncated.
+        auto tree_edits = [&](const std::shared_ptr<BufferTree>& tree) {
+            return tree->bufferCount() +
+                   (tree->hasDriverCell() && tree->driverCell() != driver_lib
+                        ? 1
+                        : 0);
+        };
+        if (buff_tree &&
+            !options->budget.fits(getEditCount(), tree_edits(buff_tree)))
+        {
+            PSN_LOG_DEBUG("Repairing {} exceeds the edit budget",
+                          handler.name(pin));
+            return added_buffers;
+        }
+        if (max_req_tree &&
+            !options->budget.fits(getEditCount(), tree_edits(max_req_tree)))
+        {
+            max_req_tree = nullptr;
+        }
         if (buff_tree)
         {
             auto sol_buf_count = buff_tree->bufferCount();
@@ -197,25 +240,21 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                                                       // solution if better
                                                       // overhead
             {
-                float buff_tree_delay =
-                    handler.gateDelay(pin, buff_tree->totalCapacitance());
                 float buff_tree_slack =
-                    buff_tree->totalRequiredOrSlew() - buff_tree_delay;
+                    buff_tree->driverRequired(psn_inst, driver_port);
 
                 for (size_t i = 1; i < buff_sol->bufferTrees().size() &&
                                    i < options->best_solution_threshold_range;
                      i++)
                 {
-                    auto& tr = buff_sol->bufferTrees()[i];
-                    float tr_delay =
-                        handler.gateDelay(pin, tr->totalCapacitance());
-                    float tr_slack = tr->totalRequiredOrSlew() - tr_delay;
+                    auto& tr       = buff_sol->bufferTrees()[i];
+                    float tr_slack = tr->driverRequired(psn_inst, driver_port);
                     if (buff_tree_slack - tr_slack <
                             options->best_solution_threshold &&
-                        tr->cost() < buff_tree->cost())
+                        tr->cost() < buff_tree->cost() &&
+                        options->budget.fits(getEditCount(), tree_edits(tr)))
                     {
                         buff_tree       = tr;
-                        buff_tree_delay = tr_delay;
                         buff_tree_slack = tr_slack;
                     }
                 }
@@ -231,9 +270,7 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                               handler.name(replace_driver));
             }
 
-            float new_delay =
-                handler.gateDelay(pin, buff_tree->totalCapacitance());
-            float new_slack = buff_tree->totalRequiredOrSlew() - new_delay;
+            float new_slack = buff_tree->driverRequired(psn_inst, driver_port);
 
             float gain = new_slack - old_slack;
             saved_slack_ += gain;
@@ -265,7 +302,8 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                 bool is_fixed = false;
                 // 3. Run pin-swap
                 if (!is_fixed && options->repair_by_pinswap &&
-                    options->current_iteration == 0)
+                    options->current_iteration == 0 &&
+                    options->budget.fits(getEditCount(), 1))
                 {
                     handler.sta()->ensureLevelized();
                     handler.sta()->vertexRequired(handler.vertex(pin),
@@ -337,7 +375,8 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                 }
                 // Try to resize before inserting the buffers
                 // 4. Upsize till no violations
-                if (!is_fixed && options->repair_by_upsize)
+                if (!is_fixed && options->repair_by_upsize &&
+                    options->budget.fits(getEditCount(), 1))
                 {
                     auto driver_types = handler.equivalentCells(
                         handler.libraryCell(driver_cell));
@@ -387,8 +426,6 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                     }
                     if (driver_lib != replaced_driver)
                     {
-                        current_area_ -= handler.area(driver_lib);
-                        current_area_ += handler.area(replaced_driver);
                         resize_up_count_++;
                     }
                     handler.sta()->vertexRequired(handler.vertex(pin),
@@ -396,11 +433,13 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                     handler.sta()->findDelays(handler.vertex(pin));
                 }
                 // 5. Buffer if not fixed by resizing
-                if (!is_fixed && !options->disable_buffering)
+                if (!is_fixed && !options->disable_buffering &&
+                    options->budget.fits(getEditCount(),
+                                         tree_edits(buff_tree)))
                 {
-                    BufferSolution::topDown(
-                        psn_inst, pin, buff_tree, current_area_, net_index_,
-                        buff_index_, added_buffers, affected_nets);
+                    BufferSolution::topDown(psn_inst, pin, buff_tree,
+                                            net_index_, buff_index_,
+                                            added_buffers, affected_nets);
                     buffer_count_ += buff_tree->bufferCount();
 
                     for (auto& net : affected_nets)
@@ -415,15 +454,18 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                     if (options->minimum_cost)
                     {
                         if (handler.hasElectricalViolation(pin) &&
-                            max_req_tree && max_req_tree != buff_tree)
+                            max_req_tree && max_req_tree != buff_tree &&
+                            options->budget.fits(
+                                getEditCount() - buff_tree->bufferCount(),
+                                tree_edits(max_req_tree)))
                         {
                             handler.ripupBuffers(added_buffers);
                             added_buffers.clear();
                             buffer_count_ -= buff_tree->bufferCount();
 
                             BufferSolution::topDown(psn_inst, pin, max_req_tree,
-                                                    current_area_, net_index_,
-                                                    buff_index_, added_buffers,
+                                                    net_index_, buff_index_,
+                                                    added_buffers,
                                                     affected_nets);
                             buffer_count_ += max_req_tree->bufferCount();
 
@@ -440,7 +482,8 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                     }
                 }
                 // 6. Resize again if not fixed by buffering
-                if (options->repair_by_upsize && !is_fixed && !is_slack_repair)
+                if (options->repair_by_upsize && !is_fixed &&
+                    !is_slack_repair && options->budget.fits(getEditCount(), 1))
                 {
                     auto driver_types = handler.equivalentCells(
                         handler.libraryCell(driver_cell));
@@ -485,17 +528,13 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
                     }
                     if (driver_lib != replaced_driver)
                     {
-                        current_area_ -= handler.area(driver_lib);
-                        current_area_ += handler.area(replaced_driver);
                         resize_up_count_++;
                     }
                 }
 
-                if (replace_driver)
+                if (replace_driver && options->budget.fits(getEditCount(), 1))
                 {
                     handler.replaceInstance(driver_cell, replace_driver);
-                    current_area_ -= handler.area(driver_lib);
-                    current_area_ += handler.area(replace_driver);
                     resize_up_count_++;
                     std::vector<Net*> fanin_nets;
                     for (auto& fpin : handler.inputPins(driver_cell))
@@ -526,6 +565,157 @@ RepairTimingTransform::repairPin(Psn* psn_inst, InstanceTerm* pin,
     return added_buffers;
 }
 
+void
+RepairTimingTransform::planRegions(
+    Psn* psn_inst, const std::vector<InstanceTerm*>& driver_pins,
+    std::unique_ptr<OptimizationOptions>& options)
+{
+    DatabaseHandler& handler = *(psn_inst->handler());
+    region_trees_.clear();
+    int  grid = options->partitions;
+    Rect core;
+    handler.top()->getCoreArea(core);
+    // Ripping up buffers changes the nets before they are repaired, so the
+    // trees cannot be planned ahead.
+    if (grid < 2 || core.dx() <= 0 || core.dy() <= 0 ||
+        options->ripup_existing_buffer_max_levels)
+    {
+        return;
+    }
+    int region_width  = (core.dx() + grid - 1) / grid;
+    int region_height = (core.dy() + grid - 1) / grid;
+    auto region_index = [&](int x, int y) -> int {
+        int col = std::min(grid - 1,
+                           std::max(0, (x - core.xMin()) / region_width));
+        int row = std::min(grid - 1,
+                           std::max(0, (y - core.yMin()) / region_height));
+        return row * grid + col;
+    };
+
+    // A driver belongs to the region containing its whole net bounding box;
+    // nets crossing a region border get their trees from repairPin().
+    auto clock_nets = handler.clockNets();
+    std::vector<std::vector<InstanceTerm*>> regions(grid * grid);
+    std::vector<std::vector<Net*>>          region_nets(grid * grid);
+    std::vector<std::vector<std::vector<InstanceTerm*>>> region_net_pins(
+        grid * grid);
+    int boundary_count = 0;
+    for (auto& pin : driver_pins)
+    {
+        auto pin_net = handler.net(pin);
+        if (!pin_net || clock_nets.count(pin_net) ||
+            handler.isSpecial(pin_net) ||
+            handler.indexedViolation(pin) == ElectircalViolation::None)
+        {
+            continue;
+        }
+        auto net_pins = handler.connectedPins(pin_net);
+        if (net_pins.empty())
+        {
+            continue;
+        }
+        auto first_loc = handler.location(net_pins[0]);
+        Rect bbox(first_loc, first_loc);
+        for (auto& net_pin : net_pins)
+        {
+            auto loc = handler.location(net_pin);
+            bbox.merge(Rect(loc, loc));
+        }
+        int low  = region_index(bbox.xMin(), bbox.yMin());
+        int high = region_index(bbox.xMax(), bbox.yMax());
+        if (low == high)
+        {
+            regions[low].push_back(pin);
+            region_nets[low].push_back(pin_net);
+            region_net_pins[low].push_back(std::move(net_pins));
+        }
+        else
+        {
+            boundary_count++;
+        }
+    }
+
+    // Regions do not share nets, so each worker builds the trees of whole
+    // regions into its own slots. The pins were collected above, the workers
+    // do not query the network.
+    std::vector<size_t> active_regions;
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        if (regions[i].size())
+        {
+            active_regions.push_back(i);
+        }
+    }
+    std::vector<std::vector<std::unique_ptr<SteinerTree>>> trees(
+        regions.size());
+    size_t thread_count =
+        std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                         active_regions.size());
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t i = t; i < active_regions.size(); i += thread_count)
+            {
+                auto  region_id   = active_regions[i];
+                auto& region_pins = regions[region_id];
+                auto& region_tree = trees[region_id];
+                region_tree.resize(region_pins.size());
+                for (size_t j = 0; j < region_pins.size(); j++)
+                {
+                    region_tree[j] = SteinerTree::create(
+                        region_nets[region_id][j],
+                        region_net_pins[region_id][j], psn_inst);
+                }
+            }
+        }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // The trees are committed serially by repairPin(), which keeps visiting
+    // the drivers in reverse level order.
+    for (auto& region_id : active_regions)
+    {
+        for (size_t j = 0; j < regions[region_id].size(); j++)
+        {
+            if (trees[region_id][j])
+            {
+                region_trees_[regions[region_id][j]] =
+                    std::move(trees[region_id][j]);
+            }
+        }
+    }
+    PSN_LOG_INFO("Planned {} drivers in {} regions, {} boundary nets",
+                 region_trees_.size(), active_regions.size(), boundary_count);
+}
+
+std::unique_ptr<SteinerTree>
+RepairTimingTransform::plannedTree(Psn* psn_inst, InstanceTerm* pin, Net* net)
+{
+    DatabaseHandler& handler = *(psn_inst->handler());
+    auto             itr     = region_trees_.find(pin);
+    if (itr == region_trees_.end())
+    {
+        return nullptr;
+    }
+    auto tree = std::move(itr->second);
+    region_trees_.erase(itr);
+
+    // Edits to neighbouring drivers may have replaced the sinks of this net.
+    auto planned_pins = tree->pins();
+    auto current_pins = handler.connectedPins(net);
+    std::sort(planned_pins.begin(), planned_pins.end());
+    std::sort(current_pins.begin(), current_pins.end());
+    if (tree->net() != net || planned_pins != current_pins)
+    {
+        return nullptr;
+    }
+    return tree;
+}
+
 int
 RepairTimingTransform::fixCapacitanceViolations(
     Psn* psn_inst, std::vector<InstanceTerm*>& driver_pins,
@@ -535,30 +725,45 @@ RepairTimingTransform::fixCapacitanceViolations(
     DatabaseHandler& handler         = *(psn_inst->handler());
     auto             clock_nets      = handler.clockNets();
     int              last_edit_count = getEditCount();
+    if (handler.topViolations(1, ElectircalViolation::Capacitance).empty())
+    {
+        return getEditCount();
+    }
     for (auto& pin : driver_pins)
     {
+        if (options->budget.exhausted(getEditCount()))
+        {
+            break;
+        }
         auto pin_net = handler.net(pin);
         if (pin_net && !clock_nets.count(pin_net) &&
             !handler.isSpecial(pin_net))
         {
-            auto vio = handler.hasElectricalViolation(pin);
+            auto vio = handler.indexedViolation(pin);
             if (vio == ElectircalViolation::Capacitance ||
                 vio == ElectircalViolation::CapacitanceAndTransition)
             {
+                if (isProcessed(psn_inst, pin))
+                {
+                    continue;
+                }
                 PSN_LOG_DEBUG("Fixing cap. violations for pin {}",
                               handler.name(pin));
                 repairPin(psn_inst, pin, RepairTarget::RepairMaxCapacitance,
                           options);
+                markProcessed(psn_inst, pin);
+                checkpointIfDue(psn_inst, options);
                 if (options->legalization_frequency >
                     (getEditCount() - last_edit_count >=
                      options->legalization_frequency))
                 {
                     last_edit_count = buffer_count_;
                     handler.legalize();
+                    region_trees_.clear();
                 }
 
                 if (handler.hasMaximumArea() &&
-                    current_area_ > handler.maximumArea())
+                    handler.area() > handler.maximumArea())
                 {
                     PSN_LOG_WARN("Maximum utilization reached");
                     return getEditCount();
@@ -579,22 +784,35 @@ RepairTimingTransform::fixTransitionViolations(
     handler.resetDelays();
     auto clock_nets      = handler.clockNets();
     int  last_edit_count = getEditCount();
+    if (handler.topViolations(1, ElectircalViolation::Transition).empty())
+    {
+        return getEditCount();
+    }
     for (auto& pin : driver_pins)
     {
+        if (options->budget.exhausted(getEditCount()))
+        {
+            break;
+        }
         auto pin_net = handler.net(pin);
 
         if (pin_net && !clock_nets.count(pin_net) &&
             !handler.isSpecial(pin_net))
         {
-            auto net_pins = handler.pins(pin_net);
-            auto vio      = handler.hasElectricalViolation(pin);
+            auto vio = handler.indexedViolation(pin);
             if (vio == ElectircalViolation::Transition ||
                 vio == ElectircalViolation::CapacitanceAndTransition)
             {
+                if (isProcessed(psn_inst, pin))
+                {
+                    continue;
+                }
                 PSN_LOG_DEBUG("Fixing transition violations for pin {}",
                               handler.name(pin));
                 auto added_buffers = repairPin(
                     psn_inst, pin, RepairTarget::RepairMaxTransition, options);
+                markProcessed(psn_inst, pin);
+                checkpointIfDue(psn_inst, options);
 
                 if (options->legalization_frequency > 0 &&
                     (getEditCount() - last_edit_count >=
@@ -602,9 +820,10 @@ RepairTimingTransform::fixTransitionViolations(
                 {
                     last_edit_count = getEditCount();
                     handler.legalize();
+                    region_trees_.clear();
                 }
                 if (handler.hasMaximumArea() &&
-                    current_area_ > handler.maximumArea())
+                    handler.area() > handler.maximumArea())
                 {
                     PSN_LOG_WARN("Maximum utilization reached");
                     return getEditCount();
@@ -638,9 +857,19 @@ RepairTimingTransform::fixNegativeSlack(
     int unfixed_paths = 0;
     for (size_t i = 0; i < negative_slack_paths.size(); i++)
     {
+        if (options->budget.exhausted(getEditCount()))
+        {
+            PSN_LOG_INFO("Skipped {} negative slack paths",
+                         negative_slack_paths.size() - i);
+            break;
+        }
         auto& pth = negative_slack_paths[i];
         std::reverse(pth.begin(), pth.end());
         auto end_pin = pth[0].pin();
+        if (isProcessed(psn_inst, end_pin))
+        {
+            continue;
+        }
         // Refresh path
         pth                     = handler.worstSlackPath(end_pin);
         negative_slack_paths[i] = pth;
@@ -654,7 +883,8 @@ RepairTimingTransform::fixNegativeSlack(
                 auto pin = pt.pin();
                 if (!buffered_pins.count(pin))
                 {
-                    if (handler.isAnyOutput(pin))
+                    if (handler.isAnyOutput(pin) &&
+                        !options->budget.exhausted(getEditCount()))
                     {
                         repairPin(psn_inst, pin, RepairTarget::RepairSlack,
                                   options);
@@ -667,7 +897,7 @@ RepairTimingTransform::fixNegativeSlack(
                         }
 
                         if (handler.hasMaximumArea() &&
-                            current_area_ > handler.maximumArea())
+                            handler.area() > handler.maximumArea())
                         {
                             PSN_LOG_WARN("Maximum utilization reached");
                             return getEditCount();
@@ -687,6 +917,8 @@ RepairTimingTransform::fixNegativeSlack(
             }
         }
         float new_slack = handler.worstSlack(end_pin);
+        markProcessed(psn_inst, end_pin);
+        checkpointIfDue(psn_inst, options);
         if (new_slack < 0.0 && init_slack == new_slack)
         {
 
@@ -738,8 +970,11 @@ void
 RepairTimingTransform::resizeDown(Psn* psn_inst, InstanceTerm* pin,
                                   std::unique_ptr<OptimizationOptions>& options)
 {
-    DatabaseHandler& handler  = *(psn_inst->handler());
-    auto             net_pins = handler.pins(handler.net(pin));
+    DatabaseHandler& handler = *(psn_inst->handler());
+    if (!options->budget.fits(getEditCount(), 1))
+    {
+        return;
+    }
     handler.sta()->ensureLevelized();
     handler.sta()->vertexRequired(handler.vertex(pin), sta::MinMax::min());
     handler.sta()->findDelays(handler.vertex(pin));
@@ -804,8 +1039,6 @@ RepairTimingTransform::resizeDown(Psn* psn_inst, InstanceTerm* pin,
             }
             if (replace_lib != init_lib)
             {
-                current_area_ -= handler.area(init_lib);
-                current_area_ += handler.area(replace_lib);
                 resize_down_count_++;
             }
         }
@@ -818,6 +1051,232 @@ RepairTimingTransform::getEditCount() const
            pin_swap_count_;
 }
 
+bool
+RepairTimingTransform::isProcessed(Psn* psn_inst, InstanceTerm* pin) const
+{
+    return !processed_pins_.empty() &&
+           processed_pins_.count(psn_inst->handler()->name(pin));
+}
+
+void
+RepairTimingTransform::markProcessed(Psn* psn_inst, InstanceTerm* pin)
+{
+    if (!checkpoint_path_.empty())
+    {
+        processed_pins_.insert(psn_inst->handler()->name(pin));
+    }
+}
+
+void
+RepairTimingTransform::checkpointIfDue(
+    Psn* psn_inst, std::unique_ptr<OptimizationOptions>& options)
+{
+    if (!checkpoint_path_.empty() && checkpoint_frequency_ > 0 &&
+        getEditCount() - last_checkpoint_edits_ >= checkpoint_frequency_)
+    {
+        checkpoint(psn_inst, options);
+    }
+}
+
+void
+RepairTimingTransform::checkpoint(Psn*                                  psn_inst,
+                                  std::unique_ptr<OptimizationOptions>& options)
+{
+    waitForSnapshot();
+    last_checkpoint_edits_ = getEditCount();
+
+    std::ostringstream state;
+    state << std::setprecision(std::numeric_limits<float>::max_digits10);
+    // The design summary lets a resumed run verify that the loaded design
+    // is this snapshot.
+    auto block = psn_inst->database()->getChip()->getBlock();
+    state << "repair_timing_checkpoint 2\n";
+    state << "design " << block->getName() << "\n";
+    state << "instances " << block->getInsts().size() << "\n";
+    state << "nets " << block->getNets().size() << "\n";
+    state << "iteration " << options->current_iteration << "\n";
+    state << "phase " << static_cast<int>(current_phase_) << "\n";
+    state << "buffer_count " << buffer_count_ << "\n";
+    state << "resize_up_count " << resize_up_count_ << "\n";
+    state << "resize_down_count " << resize_down_count_ << "\n";
+    state << "pin_swap_count " << pin_swap_count_ << "\n";
+    state << "net_count " << net_count_ << "\n";
+    state << "net_index " << net_index_ << "\n";
+    state << "buff_index " << buff_index_ << "\n";
+    state << "saved_slack " << saved_slack_ << "\n";
+    state << "initial_area " << options->initial_area << "\n";
+    for (auto& pin_name : processed_pins_)
+    {
+        state << "processed " << pin_name << "\n";
+    }
+
+    // The state file is written along with the snapshot so that the
+    // previous checkpoint is only replaced once both files are complete.
+    SnapshotWriter::ExtraFiles state_file = {
+        std::make_pair(checkpoint_path_, state.str())};
+    if (!snapshot_writer_.write(psn_inst->database(), checkpoint_path_ + ".odb",
+                                false, state_file))
+    {
+        PSN_LOG_ERROR("Failed to snapshot the design for checkpoint {}",
+                      checkpoint_path_);
+        return;
+    }
+    snapshot_pending_ = true;
+    PSN_LOG_INFO("Checkpoint {} at iteration {} after {} edits",
+                 checkpoint_path_, options->current_iteration + 1,
+                 getEditCount());
+}
+
+void
+RepairTimingTransform::finishPhase(Psn*                                  psn_inst,
+                                   std::unique_ptr<OptimizationOptions>& options,
+                                   RepairPhase                           next_phase)
+{
+    // A phase cut short by the budget is checkpointed as is so that a
+    // resumed run picks it up where it stopped.
+    if (!options->budget.isExhausted())
+    {
+        processed_pins_.clear();
+        current_phase_ = next_phase;
+    }
+    if (!checkpoint_path_.empty())
+    {
+        checkpoint(psn_inst, options);
+    }
+}
+
+void
+RepairTimingTransform::waitForSnapshot()
+{
+    if (snapshot_pending_)
+    {
+        snapshot_pending_ = false;
+        if (!snapshot_writer_.wait())
+        {
+            PSN_LOG_ERROR("Failed to write checkpoint {}", checkpoint_path_);
+        }
+    }
+}
+
+bool
+RepairTimingTransform::loadCheckpoint(
+    Psn* psn_inst, const std::string& path,
+    std::unique_ptr<OptimizationOptions>& options)
+{
+    std::ifstream state(path);
+    std::string   header;
+    int           version = 0;
+    if (!state.is_open() || !(state >> header >> version) ||
+        header != "repair_timing_checkpoint" || version != 2)
+    {
+        PSN_LOG_ERROR("Invalid repair_timing checkpoint {}", path);
+        return false;
+    }
+    // A fresh session loads the snapshot; otherwise the current design has
+    // to match the snapshot summary below.
+    if (!psn_inst->database()->getChip())
+    {
+        std::string snapshot = path + ".odb";
+        if (!psn_inst->readDatabase(snapshot.c_str()))
+        {
+            PSN_LOG_ERROR("Failed to read checkpoint snapshot {}", snapshot);
+            return false;
+        }
+    }
+    std::string key;
+    std::string design_name;
+    long        instance_count = -1;
+    long        net_count      = -1;
+    while (state >> key)
+    {
+        if (key == "design")
+        {
+            state >> design_name;
+        }
+        else if (key == "instances")
+        {
+            state >> instance_count;
+        }
+        else if (key == "nets")
+        {
+            state >> net_count;
+        }
+        else if (key == "processed")
+        {
+            std::string pin_name;
+            std::getline(state >> std::ws, pin_name);
+            processed_pins_.insert(pin_name);
+        }
+        else if (key == "iteration")
+        {
+            state >> resume_iteration_;
+        }
+        else if (key == "phase")
+        {
+            int phase = 0;
+            state >> phase;
+            resume_phase_ = static_cast<RepairPhase>(phase);
+        }
+        else if (key == "buffer_count")
+        {
+            state >> buffer_count_;
+        }
+        else if (key == "resize_up_count")
+        {
+            state >> resize_up_count_;
+        }
+        else if (key == "resize_down_count")
+        {
+            state >> resize_down_count_;
+        }
+        else if (key == "pin_swap_count")
+        {
+            state >> pin_swap_count_;
+        }
+        else if (key == "net_count")
+        {
+            state >> net_count_;
+        }
+        else if (key == "net_index")
+        {
+            state >> net_index_;
+        }
+        else if (key == "buff_index")
+        {
+            state >> buff_index_;
+        }
+        else if (key == "saved_slack")
+        {
+            state >> saved_slack_;
+        }
+        else if (key == "initial_area")
+        {
+            state >> options->initial_area;
+        }
+        else
+        {
+            std::string ignored;
+            std::getline(state, ignored);
+        }
+    }
+    auto block = psn_inst->database()->getChip()->getBlock();
+    if (!block || design_name != block->getName() ||
+        instance_count != (long)block->getInsts().size() ||
+        net_count != (long)block->getNets().size())
+    {
+        PSN_LOG_ERROR("The loaded design does not match checkpoint {}, load "
+                      "{}.odb or clear the database before resuming",
+                      path, path);
+        return false;
+    }
+    last_checkpoint_edits_ = getEditCount();
+    PSN_LOG_INFO("Resuming from iteration {} with {} edits and {} processed "
+                 "pins",
+                 resume_iteration_ + 1, getEditCount(),
+                 processed_pins_.size());
+    return true;
+}
+
 int
 RepairTimingTransform::repairTiming(
     Psn* psn_inst, std::unique_ptr<OptimizationOptions>& options,
@@ -912,19 +1371,33 @@ RepairTimingTransform::repairTiming(
     PSN_LOG_INFO("Mode: {}",
                  options->timerless ? "Timerless" : "Timing-Driven");
 
-    for (int i = 0; i < options->max_iterations; i++)
+    // Built once, then only nets touched by each edit are re-checked.
+    handler.buildViolationIndex();
+    options->budget.start(getEditCount());
+    for (int i = resume_iteration_; i < options->max_iterations; i++)
     {
+        if (options->budget.exhausted(getEditCount()))
+        {
+            break;
+        }
         PSN_LOG_INFO("Iteration {}", i + 1);
         options->current_iteration = i;
         auto driver_pins           = handler.levelDriverPins(true);
-        bool hasVio                = false;
-        int  pre_fix_count         = 0;
-
-        if (options->repair_transition_violations)
+        // Phases completed before the checkpoint are skipped on resume.
+        bool resumed = i == resume_iteration_;
+        bool hasVio =
+            resumed && resume_phase_ != RepairPhase::Transition;
+        int pre_fix_count = 0;
+
+        if (options->repair_transition_violations &&
+            !(resumed && resume_phase_ > RepairPhase::Transition))
         {
-            pre_fix_count = getEditCount();
+            current_phase_ = RepairPhase::Transition;
+            pre_fix_count  = getEditCount();
+            planRegions(psn_inst, driver_pins, options);
             // Run electrical correction (transition violation) pass
             fixTransitionViolations(psn_inst, driver_pins, options);
+            region_trees_.clear();
             if (pre_fix_count != getEditCount())
             {
                 hasVio = true;
@@ -936,13 +1409,22 @@ RepairTimingTransform::repairTiming(
                                   handler.capacitancePerMicron(), false);
             }
             driver_pins = handler.levelDriverPins(true);
+            finishPhase(psn_inst, options, RepairPhase::Capacitance);
+        }
+        if (options->budget.isExhausted())
+        {
+            break;
         }
 
-        if (options->repair_capacitance_violations)
+        if (options->repair_capacitance_violations &&
+            !(resumed && resume_phase_ > RepairPhase::Capacitance))
         {
-            pre_fix_count = getEditCount();
+            current_phase_ = RepairPhase::Capacitance;
+            pre_fix_count  = getEditCount();
+            planRegions(psn_inst, driver_pins, options);
             // Run electrical correction (capacitance violation) pass
             fixCapacitanceViolations(psn_inst, driver_pins, options);
+            region_trees_.clear();
             if (pre_fix_count != getEditCount())
             {
                 hasVio = true;
@@ -955,11 +1437,18 @@ RepairTimingTransform::repairTiming(
                                   handler.capacitancePerMicron(), false);
             }
             driver_pins = handler.levelDriverPins(true);
+            finishPhase(psn_inst, options, RepairPhase::NegativeSlack);
+        }
+        if (options->budget.isExhausted())
+        {
+            break;
         }
 
-        if (options->repair_negative_slack)
+        if (options->repair_negative_slack &&
+            !(resumed && resume_phase_ > RepairPhase::NegativeSlack))
         {
-            pre_fix_count = getEditCount();
+            current_phase_ = RepairPhase::NegativeSlack;
+            pre_fix_count  = getEditCount();
             // Run negative slack pass
             fixNegativeSlack(psn_inst, driver_pins, options);
             if (pre_fix_count != getEditCount())
@@ -973,6 +1462,11 @@ RepairTimingTransform::repairTiming(
                                   handler.capacitancePerMicron(), false);
             }
             driver_pins = handler.levelDriverPins(true);
+            finishPhase(psn_inst, options, RepairPhase::Done);
+        }
+        if (options->budget.isExhausted())
+        {
+            break;
         }
         handler.setWireRC(handler.resistancePerMicron(),
                           handler.capacitancePerMicron(), false);
@@ -991,8 +1485,11 @@ RepairTimingTransform::repairTiming(
             break;
         }
     }
+    resume_iteration_ = 0;
+    resume_phase_     = RepairPhase::Transition;
+    processed_pins_.clear();
 
-    if (options->repair_by_downsize)
+    if (options->repair_by_downsize && !options->budget.isExhausted())
     {
         // Run final downsizing phase for any extra area recovery
         auto driver_pins = handler.levelDriverPins(true);
@@ -1010,6 +1507,23 @@ RepairTimingTransform::repairTiming(
         handler.setWireRC(handler.resistancePerMicron(),
                           handler.capacitancePerMicron(), false);
     }
+    handler.clearViolationIndex();
+    waitForSnapshot();
+    if (options->budget.isExhausted())
+    {
+        // Each repair is committed as a whole, so stopping between repairs
+        // leaves the netlist consistent; report what was left.
+        PSN_LOG_WARN("Optimization stopped early by the budget");
+        PSN_LOG_INFO("Remaining transition violations: {}",
+                     handler.maximumTransitionViolations().size());
+        PSN_LOG_INFO("Remaining capacitance violations: {}",
+                     handler.maximumCapacitanceViolations().size());
+        PSN_LOG_INFO("Worst slack: {}", handler.worstSlack());
+        if (options->repair_by_downsize)
+        {
+            PSN_LOG_INFO("Skipped the downsizing phase");
+        }
+    }
     auto end      = std::chrono::high_resolution_clock::now();
     auto runtime  = end - start;
     current_area_ = handler.area();
@@ -1043,6 +1557,14 @@ RepairTimingTransform::run(Psn* psn_inst, std::vector<std::string> args)
         psn_inst->handler()->maximumCapacitanceViolations().size();
     transition_violations_ =
         psn_inst->handler()->maximumTransitionViolations().size();
+    checkpoint_frequency_  = 0;
+    last_checkpoint_edits_ = 0;
+    resume_iteration_      = 0;
+    resume_phase_          = RepairPhase::Transition;
+    current_phase_         = RepairPhase::Transition;
+    checkpoint_path_.clear();
+    processed_pins_.clear();
+    std::string resume_path;
 
     std::unique_ptr<OptimizationOptions> options(new OptimizationOptions);
 
@@ -1081,6 +1603,12 @@ RepairTimingTransform::run(Psn* psn_inst, std::vector<std::string> args)
          "-post_place",              // Post placement phase mode
          "-post_route", // Post routing phase mode (not currently supported)
          "-legalization_frequency", // Legalize after how many edit
+         "-partitions",             // Grid size for region-partitioned repair
+         "-time_budget",            // Wall-clock limit in seconds
+         "-max_edits",              // Maximum number of design edits
+         "-checkpoint",             // Checkpoint file to write
+         "-checkpoint_frequency",   // Edits between checkpoints
+         "-resume",                 // Checkpoint file to resume from
          "-fast"}); // Trade-off runtime versus optimization quality by
                     // aggressive pruning
 
@@ -1292,6 +1820,73 @@ RepairTimingTransform::run(Psn* psn_inst, std::vector<std::string> args)
                 "Post-routing optimization is not currently supported.");
             return -1;
         }
+        else if (args[i] == "-time_budget")
+        {
+            i++;
+            if (i >= args.size() || !StringUtils::isNumber(args[i]))
+            {
+                PSN_LOG_ERROR(help());
+                return -1;
+            }
+            else
+            {
+                options->budget.setTimeBudget(atof(args[i].c_str()));
+            }
+        }
+        else if (args[i] == "-max_edits")
+        {
+            i++;
+            if (i >= args.size() || !StringUtils::isNumber(args[i]))
+            {
+                PSN_LOG_ERROR(help());
+                return -1;
+            }
+            else
+            {
+                options->budget.setMaxEdits(atoi(args[i].c_str()));
+            }
+        }
+        else if (args[i] == "-checkpoint" || args[i] == "-resume")
+        {
+            auto& path = args[i] == "-checkpoint" ? checkpoint_path_
+                                                  : resume_path;
+            i++;
+            if (i >= args.size() || keywords.count(args[i]))
+            {
+                PSN_LOG_ERROR(help());
+                return -1;
+            }
+            else
+            {
+                path = args[i];
+            }
+        }
+        else if (args[i] == "-checkpoint_frequency")
+        {
+            i++;
+            if (i >= args.size() || !StringUtils::isNumber(args[i]))
+            {
+                PSN_LOG_ERROR(help());
+                return -1;
+            }
+            else
+            {
+                checkpoint_frequency_ = atoi(args[i].c_str());
+            }
+        }
+        else if (args[i] == "-partitions")
+        {
+            i++;
+            if (i >= args.size() || !StringUtils::isNumber(args[i]))
+            {
+                PSN_LOG_ERROR(help());
+                return -1;
+            }
+            else
+            {
+                options->partitions = atoi(args[i].c_str());
+            }
+        }
         else if (args[i] == "-fast")
         {
             options->minimum_upstream_resistance = 600;
@@ -1320,6 +1915,18 @@ RepairTimingTransform::run(Psn* psn_inst, std::vector<std::string> args)
 
     PSN_LOG_DEBUG("repair_timing {}", StringUtils::join(args, " "));
 
+    if (resume_path.size())
+    {
+        if (checkpoint_path_.empty())
+        {
+            checkpoint_path_ = resume_path;
+        }
+        if (!loadCheckpoint(psn_inst, resume_path, options))
+        {
+            return -1;
+        }
+    }
+
     return repairTiming(psn_inst, options, buffer_lib_names,
                         inverter_lib_names);
 }
@@ -31,6 +31,9 @@
 
 #include <cstring>
 #include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include "OpenPhySyn/Database/Types.hpp"
 #include "OpenPhySyn/Liberty/LibraryMapping.hpp"
@@ -38,6 +41,7 @@
 #include "OpenPhySyn/Optimize/SteinerTree.hpp"
 #include "OpenPhySyn/Psn/Psn.hpp"
 #include "OpenPhySyn/Transform/PsnTransform.hpp"
+#include "OpenPhySyn/Utils/SnapshotWriter.hpp"
 
 namespace psn
 {
@@ -49,6 +53,15 @@ class RepairTimingTransform : public PsnTransform
 {
 
 private:
+    // Passes of a repair iteration, in execution order
+    enum class RepairPhase
+    {
+        Transition,
+        Capacitance,
+        NegativeSlack,
+        Done
+    };
+
     int buffer_count_;           // Number of inserted buffers
     int resize_up_count_;        // Number of upsized cells
     int resize_down_count_;      // Number of downsized cells
@@ -63,6 +76,50 @@ private:
     float current_area_;         // Incremental area holder
     float saved_slack_;          // Total slack gain
 
+    // Steiner trees planned ahead of repairPin() by planRegions()
+    std::unordered_map<InstanceTerm*, std::unique_ptr<SteinerTree>>
+        region_trees_;
+
+    // Group the violating drivers by region and plan their Steiner trees
+    // concurrently, one region per worker; nets crossing a region border are
+    // left to repairPin(). The repair order of driver_pins is kept.
+    void planRegions(Psn*                                  psn_inst,
+                     const std::vector<InstanceTerm*>&     driver_pins,
+                     std::unique_ptr<OptimizationOptions>& options);
+
+    // Take the planned tree of a driver if its net is still unchanged
+    std::unique_ptr<SteinerTree> plannedTree(Psn* psn_inst, InstanceTerm* pin,
+                                             Net* net);
+
+    // Checkpoint state; pins are recorded by name so that they can be
+    // matched against the reloaded design snapshot
+    std::string                     checkpoint_path_;
+    int                             checkpoint_frequency_;
+    int                             last_checkpoint_edits_;
+    int                             resume_iteration_;
+    RepairPhase                     resume_phase_;
+    RepairPhase                     current_phase_;
+    std::unordered_set<std::string> processed_pins_;
+    SnapshotWriter                  snapshot_writer_;
+    bool                            snapshot_pending_;
+
+    // Skip pins already handled in the current phase of a resumed run
+    bool isProcessed(Psn* psn_inst, InstanceTerm* pin) const;
+    void markProcessed(Psn* psn_inst, InstanceTerm* pin);
+
+    // Write the state file and the design snapshot; the snapshot is
+    // serialized in memory and flushed to disk on a background thread
+    void checkpoint(Psn*                                  psn_inst,
+                    std::unique_ptr<OptimizationOptions>& options);
+    void checkpointIfDue(Psn*                                  psn_inst,
+                         std::unique_ptr<OptimizationOptions>& options);
+    void finishPhase(Psn*                                  psn_inst,
+                     std::unique_ptr<OptimizationOptions>& options,
+                     RepairPhase                           next_phase);
+    bool loadCheckpoint(Psn* psn_inst, const std::string& path,
+                        std::unique_ptr<OptimizationOptions>& options);
+    void waitForSnapshot();
+
     // Repair a single pin
     std::unordered_set<Instance*>
     repairPin(Psn* psn_inst, InstanceTerm* pin, RepairTarget target,
@@ -103,6 +160,7 @@ private:
 
 public:
     RepairTimingTransform();
+    ~RepairTimingTransform();
 
     // Run the transform and capture user configurations
     int run(Psn* psn_inst, std::vector<std::string> args) override;
@@ -121,5 +179,8 @@ DEFINE_TRANSFORM(
     "[-buffer_disabled] [-minimum_cost_buffer_enabled] [-upsize_enabled] "
     "[-downsize_enabled] [-pin_swap_enabled] [-legalize_eventually] "
     "[-legalize_each_iteration] [-post_place|-post_route] "
-    "[-legalization_frequency <num_edits>] [-fast]")
+    "[-legalization_frequency <num_edits>] [-partitions <grid_size>] "
+    "[-time_budget <seconds>] [-max_edits <num_edits>] "
+    "[-checkpoint <path>] [-checkpoint_frequency <num_edits>] "
+    "[-resume <path>] [-fast]")
 } // namespace psn
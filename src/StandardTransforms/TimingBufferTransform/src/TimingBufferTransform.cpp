@@ -172,6 +172,22 @@ TimingBufferTransform::bufferPin(Psn* psn_inst, InstanceTerm* pin,
                 buff_sol->optimalDriverTree(psn_inst, pin, inv_buff_tree, 0);
         }
 
+        // A buffering is committed as a whole, so a tree that does not fit in
+        // the remaining edit budget is dropped instead of being truncated.
+        int  edit_count = buffer_count_ + resize_count_;
+        auto tree_edits = [&](const std::shared_ptr<BufferTree>& tree) {
+            return tree->bufferCount() +
+                   (tree->hasDriverCell() && tree->driverCell() != driver_lib
+                        ? 1
+                        : 0);
+        };
+        if (buff_tree &&
+            !options->budget.fits(edit_count, tree_edits(buff_tree)))
+        {
+            PSN_LOG_DEBUG("Buffering {} exceeds the edit budget",
+                          handler.name(pin));
+            return added_buffers;
+        }
         if (buff_tree)
         {
             if (options->repair_by_resynthesis &&
@@ -235,8 +251,6 @@ TimingBufferTransform::bufferPin(Psn* psn_inst, InstanceTerm* pin,
                         {
                             handler.replaceInstance(driver_cell,
                                                     closest_inverse);
-                            current_area_ -= handler.area(driver_lib);
-                            current_area_ += handler.area(closest_inverse);
                             std::vector<Net*> fanin_nets;
                             for (auto& fpin : handler.inputPins(driver_cell))
                             {
@@ -253,37 +267,35 @@ TimingBufferTransform::bufferPin(Psn* psn_inst, InstanceTerm* pin,
                     }
                 }
             }
-            auto sol_buf_count = buff_tree->bufferCount();
-            if (sol_buf_count)
-            {
-                buffer_count_ += sol_buf_count;
-                net_count_++;
-            }
+            // Slacks are taken at the corner each tree is worst in.
+            auto driver_port = handler.libraryPin(pin);
             if (options->use_best_solution_threshold)
             {
-                float buff_tree_delay =
-                    handler.gateDelay(pin, buff_tree->totalCapacitance());
                 float buff_tree_slack =
-                    buff_tree->totalRequiredOrSlew() - buff_tree_delay;
+                    buff_tree->driverRequired(psn_inst, driver_port);
 
                 for (size_t i = 1; i < buff_sol->bufferTrees().size() &&
                                    i < options->best_solution_threshold_range;
                      i++)
                 {
-                    auto& tr = buff_sol->bufferTrees()[i];
-                    float tr_delay =
-                        handler.gateDelay(pin, tr->totalCapacitance());
-                    float tr_slack = tr->totalRequiredOrSlew() - tr_delay;
+                    auto& tr       = buff_sol->bufferTrees()[i];
+                    float tr_slack = tr->driverRequired(psn_inst, driver_port);
                     if (buff_tree_slack - tr_slack <
                             options->best_solution_threshold &&
-                        tr->cost() < buff_tree->cost())
+                        tr->cost() < buff_tree->cost() &&
+                        options->budget.fits(edit_count, tree_edits(tr)))
                     {
                         buff_tree       = tr;
-                        buff_tree_delay = tr_delay;
                         buff_tree_slack = tr_slack;
                     }
                 }
             }
+            auto sol_buf_count = buff_tree->bufferCount();
+            if (sol_buf_count)
+            {
+                buffer_count_ += sol_buf_count;
+                net_count_++;
+            }
 
             replace_driver = (buff_tree->hasDriverCell() &&
                               buff_tree->driverCell() != driver_lib)
@@ -294,26 +306,19 @@ TimingBufferTransform::bufferPin(Psn* psn_inst, InstanceTerm* pin,
                 PSN_LOG_DEBUG("Replace {} with {}", handler.name(driver_lib),
                               handler.name(replace_driver));
             }
-            float old_delay =
-                handler.gateDelay(pin, no_buff_tree->totalCapacitance());
-            float old_slack = no_buff_tree->totalRequiredOrSlew() - old_delay;
-
-            float new_delay =
-                handler.gateDelay(pin, buff_tree->totalCapacitance());
-            float new_slack = buff_tree->totalRequiredOrSlew() - new_delay;
+            float old_slack =
+                no_buff_tree->driverRequired(psn_inst, driver_port);
+            float new_slack = buff_tree->driverRequired(psn_inst, driver_port);
 
             float gain = new_slack - old_slack;
             saved_slack_ += gain;
 
-            BufferSolution::topDown(psn_inst, pin, buff_tree, current_area_,
-                                    net_index_, buff_index_, added_buffers,
-                                    affected_nets);
+            BufferSolution::topDown(psn_inst, pin, buff_tree, net_index_,
+                                    buff_index_, added_buffers, affected_nets);
 
             if (replace_driver)
             {
                 handler.replaceInstance(driver_cell, replace_driver);
-                current_area_ -= handler.area(driver_lib);
-                current_area_ += handler.area(replace_driver);
                 resize_count_++;
             }
             for (auto& net : affected_nets)
@@ -340,12 +345,20 @@ TimingBufferTransform::fixCapacitanceViolations(
     DatabaseHandler& handler           = *(psn_inst->handler());
     auto             clock_nets        = handler.clockNets();
     int              last_buffer_count = buffer_count_;
+    if (handler.topViolations(1, ElectircalViolation::Capacitance).empty())
+    {
+        return buffer_count_;
+    }
     for (auto& pin : driver_pins)
     {
+        if (options->budget.exhausted(buffer_count_ + resize_count_))
+        {
+            break;
+        }
         auto pin_net = handler.net(pin);
         if (pin_net && !clock_nets.count(pin_net))
         {
-            auto vio = handler.hasElectricalViolation(pin);
+            auto vio = handler.indexedViolation(pin);
             if (vio == ElectircalViolation::Capacitance ||
                 vio == ElectircalViolation::CapacitanceAndTransition)
             {
@@ -362,7 +375,7 @@ TimingBufferTransform::fixCapacitanceViolations(
                 }
 
                 if (handler.hasMaximumArea() &&
-                    current_area_ > handler.maximumArea())
+                    handler.area() > handler.maximumArea())
                 {
                     PSN_LOG_WARN("Maximum utilization reached");
                     return buffer_count_ + resize_count_;
@@ -398,6 +411,12 @@ TimingBufferTransform::fixNegativeSlack(
     int unfixed_paths = 0;
     for (size_t i = 0; i < negative_slack_paths.size(); i++)
     {
+        if (options->budget.exhausted(buffer_count_ + resize_count_))
+        {
+            PSN_LOG_INFO("Skipped {} negative slack paths",
+                         negative_slack_paths.size() - i);
+            break;
+        }
         auto& pth = negative_slack_paths[i];
         std::reverse(pth.begin(), pth.end());
         auto end_pin = pth[0].pin();
@@ -414,7 +433,9 @@ TimingBufferTransform::fixNegativeSlack(
                 auto pin = pt.pin();
                 if (!buffered_pins.count(pin))
                 {
-                    if (handler.isAnyOutput(pin))
+                    if (handler.isAnyOutput(pin) &&
+                        !options->budget.exhausted(buffer_count_ +
+                                                   resize_count_))
                     {
                         bufferPin(psn_inst, pin, RepairTarget::RepairSlack,
                                   options);
@@ -427,7 +448,7 @@ TimingBufferTransform::fixNegativeSlack(
                         }
 
                         if (handler.hasMaximumArea() &&
-                            current_area_ > handler.maximumArea())
+                            handler.area() > handler.maximumArea())
                         {
                             PSN_LOG_WARN("Maximum utilization reached");
                             return buffer_count_ + resize_count_;
@@ -476,14 +497,21 @@ TimingBufferTransform::fixTransitionViolations(
     handler.resetDelays();
     auto clock_nets        = handler.clockNets();
     int  last_buffer_count = buffer_count_;
+    if (handler.topViolations(1, ElectircalViolation::Transition).empty())
+    {
+        return buffer_count_;
+    }
     for (auto& pin : driver_pins)
     {
+        if (options->budget.exhausted(buffer_count_ + resize_count_))
+        {
+            break;
+        }
         auto pin_net = handler.net(pin);
 
         if (pin_net && !clock_nets.count(pin_net))
         {
-            auto net_pins = handler.pins(pin_net);
-            auto vio      = handler.hasElectricalViolation(pin);
+            auto vio = handler.indexedViolation(pin);
             if (vio == ElectircalViolation::Transition ||
                 vio == ElectircalViolation::CapacitanceAndTransition)
             {
@@ -500,7 +528,7 @@ TimingBufferTransform::fixTransitionViolations(
                     handler.legalize();
                 }
                 if (handler.hasMaximumArea() &&
-                    current_area_ > handler.maximumArea())
+                    handler.area() > handler.maximumArea())
                 {
                     PSN_LOG_WARN("Maximum utilization reached");
                     return buffer_count_ + resize_count_;
@@ -597,8 +625,15 @@ TimingBufferTransform::timingBuffer(
     PSN_LOG_INFO("Mode: {}",
                  options->timerless ? "Timerless" : "Timing-Driven");
 
+    // Built once, then only nets touched by each edit are re-checked.
+    handler.buildViolationIndex();
+    options->budget.start(buffer_count_ + resize_count_);
     for (int i = 0; i < options->max_iterations; i++)
     {
+        if (options->budget.exhausted(buffer_count_ + resize_count_))
+        {
+            break;
+        }
         PSN_LOG_INFO("Iteration {}", i + 1);
 
         bool hasVio         = false;
@@ -660,6 +695,19 @@ TimingBufferTransform::timingBuffer(
             break;
         }
     }
+    handler.clearViolationIndex();
+    if (options->budget.isExhausted())
+    {
+        // Each buffering is committed as a whole, so stopping between pins
+        // leaves the netlist consistent; report what was left.
+        PSN_LOG_WARN("Optimization stopped early by the budget");
+        PSN_LOG_INFO("Remaining transition violations: {}",
+                     handler.maximumTransitionViolations().size());
+        PSN_LOG_INFO("Remaining capacitance violations: {}",
+                     handler.maximumCapacitanceViolations().size());
+        PSN_LOG_INFO("Worst slack: {}", handler.worstSlack());
+    }
+    current_area_ = handler.area();
     PSN_LOG_INFO("Initial area: {}", (int)(options->initial_area * 10E12));
     PSN_LOG_INFO("New area: {}", (int)(current_area_ * 10E12));
     if (options->repair_capacitance_violations)
@@ -711,7 +759,8 @@ TimingBufferTransform::run(Psn* psn_inst, std::vector<std::string> args)
          "-min_gain", "-area_penalty", "-auto_buffer_library",
          "-minimize_buffer_library", "-use_inverting_buffer_library",
          "-timerless", "-repair_by_resynthesis", "-post_global_place",
-         "-post_place", "-post_route", "-legalization_frequency", "-fast"});
+         "-post_place", "-post_route", "-legalization_frequency",
+         "-time_budget", "-max_edits", "-fast"});
 
     if (args.size() < 2)
     {
@@ -858,6 +907,32 @@ TimingBufferTransform::run(Psn* psn_inst, std::vector<std::string> args)
                 options->legalization_frequency = atoi(args[i].c_str());
             }
         }
+        else if (args[i] == "-time_budget")
+        {
+            i++;
+            if (i >= args.size() || !StringUtils::isNumber(args[i]))
+            {
+                PSN_LOG_ERROR(help());
+                return -1;
+            }
+            else
+            {
+                options->budget.setTimeBudget(atof(args[i].c_str()));
+            }
+        }
+        else if (args[i] == "-max_edits")
+        {
+            i++;
+            if (i >= args.size() || !StringUtils::isNumber(args[i]))
+            {
+                PSN_LOG_ERROR(help());
+                return -1;
+            }
+            else
+            {
+                options->budget.setMaxEdits(atoi(args[i].c_str()));
+            }
+        }
         else if (args[i] == "-area_penalty")
         {
             i++;
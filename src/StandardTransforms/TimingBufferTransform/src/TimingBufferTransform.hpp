@@ -102,7 +102,8 @@ DEFINE_TRANSFORM(
     "<inverters library>] [-repair_by_resynthesis] [-iterations "
     "<# "
     "iterations=1>] [-post_place|-post_route] "
-    "[-legalization_frequency <numBuffer>]"
+    "[-legalization_frequency <numBuffer>] [-time_budget <seconds>] "
+    "[-max_edits <num_edits>] "
     "[-min_gain "
     "<gain=0ps>] [-enable_gate_resize] [-area_penalty <penalty=0ps/um>]")
 
@@ -38,14 +38,34 @@ namespace eval psn {
             }
     }
 
+    define_cmd_args "import_lefs" {[-tech] [-library] filenames}
+    proc import_lefs { args } {
+        sta::parse_key_args "import_lefs" args \
+            keys {} \
+            flags {-tech -library}
+        set has_tech [info exists flags(-tech)]
+        set has_lib [info exists flags(-library)]
+        if {[llength $args] != 1} {
+            sta::cmd_usage_error "import_lefs"
+            return
+        }
+        if {!$has_tech && !$has_lib} {
+            set has_tech 1
+            set has_lib 1
+        }
+        psn::import_lefs_internal [lindex $args 0] $has_lib $has_tech
+    }
+
     define_cmd_args "gate_clone" {\
         [-clone_max_cap_factor factor] \
         [-clone_non_largest_cells] \
+        [-time_budget seconds] \
+        [-max_edits num_edits] \
     }
     
     proc gate_clone { args } {
         sta::parse_key_args "gate_clone" args \
-        keys {-clone_max_cap_factor} \
+        keys {-clone_max_cap_factor -time_budget -max_edits} \
         flags {-clone_non_largest_cells}
 
         set clone_max_cap_factor 1.5
@@ -58,19 +78,27 @@ namespace eval psn {
             set clone_largest_cells_only false
         }
 
-        set num_cloned [transform gate_clone $clone_max_cap_factor $clone_largest_cells_only]
+        set budget_args ""
+        if {[info exists keys(-time_budget)]} {
+            set budget_args "$budget_args -time_budget $keys(-time_budget)"
+        }
+        if {[info exists keys(-max_edits)]} {
+            set budget_args "$budget_args -max_edits $keys(-max_edits)"
+        }
+        set num_cloned [transform gate_clone $clone_max_cap_factor $clone_largest_cells_only {*}$budget_args]
         return $num_cloned
     }
 
     define_cmd_args "pin_swap" {\
         [-path_count count]\
         [-power]\
+        [-activity]\
     }
     
     proc pin_swap { args } {
         sta::parse_key_args "pin_swap" args \
             keys {-path_count} \
-            flags {-power}
+            flags {-power -activity}
 
         set max_path_count 50
         if {[info exists keys(-path_count)]} {
@@ -80,6 +108,9 @@ namespace eval psn {
         if {[info exists flags(-power)]} {
             set power_flag "-power"
         }
+        if {[info exists flags(-activity)]} {
+            set power_flag "-activity"
+        }
         set num_swapped [transform pin_swap $max_path_count $power_flag]
         return $num_swapped
     }
@@ -157,12 +188,13 @@ namespace eval psn {
     define_cmd_args "optimize_fanout" { \
         -buffer_cell buffer_cell_name \
         -max_fanout max_fanout \
+        [-cluster] \
     }
 
     proc optimize_fanout { args } {
         sta::parse_key_args "optimize_fanout" args \
             keys {-buffer_cell -max_fanout} \
-            flags {}
+            flags {-cluster}
         if { ![info exists keys(-buffer_cell)] \
           || ![info exists keys(-max_fanout)]
          } {
@@ -170,6 +202,9 @@ namespace eval psn {
         }
         set cell $keys(-buffer_cell)
         set max_fanout $keys(-max_fanout)
+        if {[info exists flags(-cluster)]} {
+            return [transform buffer_fanout $max_fanout $cell cluster]
+        }
         transform buffer_fanout $max_fanout $cell
     }
 
@@ -228,11 +263,12 @@ namespace eval psn {
 				 [-use_inverting_buffer_library] [-buffers buffers]\
 				 [-inverters inverters ] [-iterations iterations] [-area_penalty area_penalty]\
 				 [-legalization_frequency count] [-min_gain gain] [-enable_driver_resize] \
+				 [-time_budget seconds] [-max_edits num_edits] \
     }
 
     proc timing_buffer { args } {
         sta::parse_key_args "timing_buffer" args \
-        keys {-auto_buffer_library -buffers -inverters -iterations -min_gain -area_penalty -legalization_frequency}\
+        keys {-auto_buffer_library -buffers -inverters -iterations -min_gain -area_penalty -legalization_frequency -time_budget -max_edits}\
         flags {-negative_slack_violations -timerless -capacitance_violations -transition_violations -repair_by_upsize -fast -repair_by_resynthesis -enable_driver_resize -minimize_buffer_library -use_inverting_buffer_library -capacitance_violations] -transition_violations}
         
         set buffer_lib_flag ""
@@ -341,11 +377,18 @@ namespace eval psn {
         if {[info exists flags(-enable_driver_resize)]} {
             set resize_flag  "-enable_driver_resize"
         }
+        set budget_flag ""
+        if {[info exists keys(-time_budget)]} {
+            set budget_flag "$budget_flag -time_budget $keys(-time_budget)"
+        }
+        if {[info exists keys(-max_edits)]} {
+            set budget_flag "$budget_flag -max_edits $keys(-max_edits)"
+        }
         set iterations 1
         if {[info exists keys(-iterations)]} {
             set iterations "$keys(-iterations)"
         }
-        set bufargs "$repair_target_flag $fast_mode_flag $mode_flag $auto_buf_flag $minimuze_buf_lib_flag $use_inv_buf_lib_flag $legalization_freq_flag $buffer_lib_flag $inverters_flag $min_gain_flag $resize_flag $area_penalty_flag -iterations $iterations"
+        set bufargs "$repair_target_flag $fast_mode_flag $mode_flag $auto_buf_flag $minimuze_buf_lib_flag $use_inv_buf_lib_flag $legalization_freq_flag $buffer_lib_flag $inverters_flag $min_gain_flag $resize_flag $area_penalty_flag $budget_flag -iterations $iterations"
         set affected [transform timing_buffer {*}$bufargs]
         if {$affected < 0} {
             puts "Timing buffer failed"
@@ -363,7 +406,10 @@ namespace eval psn {
         [-buffer_disabled] [-minimum_cost_buffer_enabled] [-upsize_enabled]\
         [-downsize_enabled] [-pin_swap_enabled] [-legalize_eventually]\
         [-legalize_each_iteration] [-post_place] [-post_route]\
-        [-legalization_frequency num_edits] [-fast]\
+        [-legalization_frequency num_edits] [-partitions grid_size]\
+        [-time_budget seconds] [-max_edits num_edits]\
+        [-checkpoint path] [-checkpoint_frequency num_edits] [-resume path]\
+        [-fast]\
     }
 
     proc repair_timing { args } {
@@ -0,0 +1,243 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "TransformManifest.hpp"
+#include "Utils/FileUtils.hpp"
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <sys/stat.h>
+
+namespace psn
+{
+namespace
+{
+const char* kManifestHeader = "psn_transform_manifest 1";
+
+std::string
+escapeField(const std::string& field)
+{
+    std::string escaped;
+    for (char c : field)
+    {
+        switch (c)
+        {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::vector<std::string>
+splitFields(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    for (size_t i = 0; i < line.size(); i++)
+    {
+        char c = line[i];
+        if (c == '\t')
+        {
+            fields.push_back("");
+        }
+        else if (c == '\\' && i + 1 < line.size())
+        {
+            char next = line[++i];
+            fields.back() += next == 't' ? '\t' : next == 'n' ? '\n' : next;
+        }
+        else
+        {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+} // namespace
+
+TransformManifest::TransformManifest(const std::string& dir)
+    : dir_(dir), modified_(false)
+{
+}
+
+bool
+TransformManifest::read()
+{
+    std::ifstream in(FileUtils::joinPath(dir_, fileName()));
+    std::string   line;
+    if (!in.is_open() || !std::getline(in, line) || line != kManifestHeader)
+    {
+        return false;
+    }
+    while (std::getline(in, line))
+    {
+        auto fields = splitFields(line);
+        if (fields.size() != 7)
+        {
+            continue;
+        }
+        Entry entry;
+        try
+        {
+            entry.size  = std::stoull(fields[1]);
+            entry.mtime = std::stoll(fields[2]);
+        }
+        catch (std::exception&)
+        {
+            continue;
+        }
+        entry.info = TransformInfo(fields[3], fields[6], fields[4], fields[5]);
+        entries_[fields[0]] = entry;
+    }
+    return true;
+}
+
+bool
+TransformManifest::write()
+{
+    std::string path     = FileUtils::joinPath(dir_, fileName());
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path);
+        if (!out.is_open())
+        {
+            return false;
+        }
+        out << kManifestHeader << "\n";
+        for (auto& itr : entries_)
+        {
+            auto& info = itr.second.info;
+            out << escapeField(itr.first) << "\t" << itr.second.size << "\t"
+                << itr.second.mtime << "\t" << escapeField(info.name()) << "\t"
+                << escapeField(info.version()) << "\t"
+                << escapeField(info.description()) << "\t"
+                << escapeField(info.help()) << "\n";
+        }
+        if (!out)
+        {
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    modified_ = false;
+    return true;
+}
+
+const TransformInfo*
+TransformManifest::find(const std::string& path) const
+{
+    auto itr = entries_.find(FileUtils::baseName(path));
+    if (itr == entries_.end())
+    {
+        return nullptr;
+    }
+    uint64_t size;
+    int64_t  mtime;
+    if (!fileStamp(path, size, mtime) || size != itr->second.size ||
+        mtime != itr->second.mtime)
+    {
+        return nullptr;
+    }
+    return &itr->second.info;
+}
+
+void
+TransformManifest::update(const std::string& path, TransformInfo info)
+{
+    Entry entry;
+    if (!fileStamp(path, entry.size, entry.mtime))
+    {
+        return;
+    }
+    entry.info                          = info;
+    entries_[FileUtils::baseName(path)] = entry;
+    modified_                           = true;
+}
+
+void
+TransformManifest::retain(const std::vector<std::string>& paths)
+{
+    std::map<std::string, Entry> retained;
+    for (auto& path : paths)
+    {
+        auto itr = entries_.find(FileUtils::baseName(path));
+        if (itr != entries_.end())
+        {
+            retained.insert(*itr);
+        }
+    }
+    if (retained.size() != entries_.size())
+    {
+        entries_.swap(retained);
+        modified_ = true;
+    }
+}
+
+bool
+TransformManifest::isModified() const
+{
+    return modified_;
+}
+
+const char*
+TransformManifest::fileName()
+{
+    return ".psn_transforms";
+}
+
+bool
+TransformManifest::fileStamp(const std::string& path, uint64_t& size,
+                             int64_t& mtime)
+{
+    struct stat file_stat;
+    if (stat(path.c_str(), &file_stat) != 0)
+    {
+        return false;
+    }
+    size  = file_stat.st_size;
+    mtime = file_stat.st_mtime;
+    return true;
+}
+} // namespace psn
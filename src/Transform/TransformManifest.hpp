@@ -0,0 +1,78 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "OpenPhySyn/Transform/TransformInfo.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace psn
+{
+// Index of the transform plugins in a directory, storing the metadata of
+// each shared object along with its size and modification time so that the
+// plugins can be listed without loading them.
+class TransformManifest
+{
+public:
+    explicit TransformManifest(const std::string& dir);
+
+    bool read();
+    bool write();
+
+    // Returns the recorded info of the plugin at path, or null if the
+    // plugin is not indexed or changed since it was recorded.
+    const TransformInfo* find(const std::string& path) const;
+    void                 update(const std::string& path, TransformInfo info);
+    // Drops the entries of plugins that are no longer in the directory
+    void retain(const std::vector<std::string>& paths);
+    bool isModified() const;
+
+    static const char* fileName();
+
+private:
+    struct Entry
+    {
+        uint64_t      size;
+        int64_t       mtime;
+        TransformInfo info;
+    };
+    static bool fileStamp(const std::string& path, uint64_t& size,
+                          int64_t& mtime);
+
+    std::string                  dir_;
+    std::map<std::string, Entry> entries_;
+    bool                         modified_;
+};
+} // namespace psn
@@ -51,6 +51,7 @@ namespace fs = psn::filesystem;
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <fcntl.h>
 #include <limits.h>
 #include <unistd.h>
 #endif
@@ -186,4 +187,20 @@ FileUtils::executablePath()
     return exec_path;
 #endif
 }
+void
+FileUtils::readAhead(const std::vector<std::string>& paths)
+{
+#ifndef _WIN32
+    for (auto& path : paths)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            continue;
+        }
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        close(fd);
+    }
+#endif
+}
 } // namespace psn
@@ -51,5 +51,7 @@ public:
                                              const std::string& second_path);
     static std::string              baseName(const std::string& path);
     static std::string              executablePath();
+    // Hints the kernel to start reading the files in the background.
+    static void readAhead(const std::vector<std::string>& paths);
 };
 } // namespace psn
\ No newline at end of file
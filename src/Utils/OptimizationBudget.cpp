@@ -0,0 +1,117 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "OpenPhySyn/Utils/OptimizationBudget.hpp"
+#include "OpenPhySyn/PsnLogger/PsnLogger.hpp"
+
+namespace psn
+{
+OptimizationBudget::OptimizationBudget()
+    : time_budget_(0.0),
+      max_edits_(0),
+      start_edit_count_(0),
+      exhausted_(false),
+      start_time_(std::chrono::steady_clock::now())
+{
+}
+void
+OptimizationBudget::setTimeBudget(float seconds)
+{
+    time_budget_ = seconds;
+}
+void
+OptimizationBudget::setMaxEdits(int max_edits)
+{
+    max_edits_ = max_edits;
+}
+float
+OptimizationBudget::timeBudget() const
+{
+    return time_budget_;
+}
+int
+OptimizationBudget::maxEdits() const
+{
+    return max_edits_;
+}
+bool
+OptimizationBudget::hasLimit() const
+{
+    return time_budget_ > 0.0 || max_edits_ > 0;
+}
+void
+OptimizationBudget::start(int start_edit_count)
+{
+    start_edit_count_ = start_edit_count;
+    exhausted_        = false;
+    start_time_       = std::chrono::steady_clock::now();
+}
+bool
+OptimizationBudget::exhausted(int edit_count)
+{
+    if (exhausted_)
+    {
+        return true;
+    }
+    int edits = edit_count - start_edit_count_;
+    if (max_edits_ > 0 && edits >= max_edits_)
+    {
+        PSN_LOG_WARN("Edit budget of {} exhausted after {}s", max_edits_,
+                     elapsed());
+        exhausted_ = true;
+    }
+    else if (time_budget_ > 0.0 && elapsed() >= time_budget_)
+    {
+        PSN_LOG_WARN("Time budget of {}s exhausted after {} edits",
+                     time_budget_, edits);
+        exhausted_ = true;
+    }
+    return exhausted_;
+}
+bool
+OptimizationBudget::fits(int edit_count, int edits) const
+{
+    return max_edits_ <= 0 ||
+           edit_count - start_edit_count_ + edits <= max_edits_;
+}
+bool
+OptimizationBudget::isExhausted() const
+{
+    return exhausted_;
+}
+float
+OptimizationBudget::elapsed() const
+{
+    return std::chrono::duration<float>(std::chrono::steady_clock::now() -
+                                        start_time_)
+        .count();
+}
+} // namespace psn
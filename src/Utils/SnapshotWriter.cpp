@@ -0,0 +1,169 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "OpenPhySyn/Utils/SnapshotWriter.hpp"
+#include "opendb/db.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <zlib.h>
+
+namespace psn
+{
+namespace
+{
+const size_t kCompressBufferSize = 1 << 22;
+} // namespace
+
+SnapshotWriter::SnapshotWriter() : running_(false), failed_(false)
+{
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    wait();
+}
+
+bool
+SnapshotWriter::write(Database* db, const std::string& path, bool compress,
+                      const ExtraFiles& extra_files)
+{
+    wait();
+    path_ = path;
+
+    char*  buffer = nullptr;
+    size_t size   = 0;
+    FILE*  stream = open_memstream(&buffer, &size);
+    if (!stream)
+    {
+        failed_ = true;
+        return false;
+    }
+    db->write(stream);
+    fclose(stream);
+
+    running_ = true;
+    failed_  = false;
+    auto write_snapshot = [this, path, compress, extra_files, buffer, size]() {
+        std::vector<std::pair<std::string, std::string>> renames;
+        renames.push_back(std::make_pair(path + ".tmp", path));
+        bool ok = writeFile(renames.back().first, buffer, size, compress);
+        free(buffer);
+        for (auto& file : extra_files)
+        {
+            if (!ok)
+            {
+                break;
+            }
+            renames.push_back(std::make_pair(file.first + ".tmp", file.first));
+            ok = writeFile(renames.back().first, file.second.data(),
+                           file.second.size(), false);
+        }
+        for (auto& rename : renames)
+        {
+            if (ok)
+            {
+                ok = std::rename(rename.first.c_str(), rename.second.c_str()) ==
+                     0;
+            }
+            else
+            {
+                std::remove(rename.first.c_str());
+            }
+        }
+        failed_  = !ok;
+        running_ = false;
+    };
+    thread_ = std::thread(write_snapshot);
+    return true;
+}
+
+bool
+SnapshotWriter::wait()
+{
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+    return !failed_;
+}
+
+bool
+SnapshotWriter::isRunning() const
+{
+    return running_;
+}
+
+bool
+SnapshotWriter::hasFailed() const
+{
+    return failed_;
+}
+
+const std::string&
+SnapshotWriter::path() const
+{
+    return path_;
+}
+
+bool
+SnapshotWriter::writeFile(const std::string& path, const char* data,
+                          size_t size, bool compress)
+{
+    if (compress)
+    {
+        gzFile file = gzopen(path.c_str(), "wb1");
+        if (!file)
+        {
+            return false;
+        }
+        gzbuffer(file, kCompressBufferSize);
+        bool ok = true;
+        while (ok && size > 0)
+        {
+            unsigned int chunk =
+                static_cast<unsigned int>(std::min<size_t>(size, 1u << 30));
+            ok = gzwrite(file, data, chunk) == static_cast<int>(chunk);
+            data += chunk;
+            size -= chunk;
+        }
+        return gzclose(file) == Z_OK && ok;
+    }
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file)
+    {
+        return false;
+    }
+    bool ok = fwrite(data, 1, size, file) == size;
+    return fclose(file) == 0 && ok;
+}
+} // namespace psn
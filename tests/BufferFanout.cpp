@@ -33,6 +33,8 @@
 #include "Utils/FileUtils.hpp"
 #include "doctest.h"
 
+#include <cstdlib>
+
 namespace psn
 {
 
@@ -58,4 +60,61 @@ TEST_CASE("testing buffer_fanout transform")
         FAIL(e.what());
     }
 }
+TEST_CASE("testing clustered buffer_fanout transform")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+        auto result = psn_inst.runTransform(
+            "buffer_fanout",
+            std::vector<std::string>({"2", "BUF_X1", "cluster"}));
+        CHECK(result > 0);
+        auto handler = psn_inst.handler();
+        for (auto& net : handler->nets())
+        {
+            if (!handler->isPrimary(net))
+            {
+                CHECK(handler->fanoutCount(net) <= 2);
+            }
+        }
+        // Each buffer sits at the centroid of the sinks it drives, up to the
+        // offset of the buffer input pins standing in for lower clusters.
+        int buffer_count = 0;
+        for (auto& inst : handler->instances())
+        {
+            if (handler->name(inst).find("fanout_buf_") != 0)
+            {
+                continue;
+            }
+            buffer_count++;
+            auto out_net = handler->net(handler->outputPins(inst)[0]);
+            auto sinks   = handler->fanoutPins(out_net);
+            REQUIRE(sinks.size() > 0);
+            long sum_x = 0;
+            long sum_y = 0;
+            for (auto& sink : sinks)
+            {
+                sum_x += handler->location(sink).getX();
+                sum_y += handler->location(sink).getY();
+            }
+            long count    = sinks.size();
+            auto location = handler->location(inst);
+            int  dx       = std::abs(location.getX() - sum_x / count);
+            int  dy       = std::abs(location.getY() - sum_y / count);
+            CHECK(handler->dbuToMeters(dx) < 2E-6);
+            CHECK(handler->dbuToMeters(dy) < 2E-6);
+        }
+        CHECK(buffer_count == result);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
 } // namespace psn
\ No newline at end of file
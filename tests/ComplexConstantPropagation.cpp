@@ -61,4 +61,42 @@ TEST_CASE("testing deep multi-level constant_propagation")
         FAIL(e.what());
     }
 }
+TEST_CASE("testing constant_propagation with multiple constant inputs")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/multi_constant_propagation/"
+                         "multi_constant_propagation.def");
+        auto handler = psn_inst.handler();
+        CHECK(handler->instances().size() == 4);
+        psn_inst.runTransform("constant_propagation",
+                              std::vector<std::string>({}));
+        // NAND2(1, 0) folds to 1, which reduces AND2(1, x) to x; the output
+        // port keeps its net and is driven by a buffer from the input port.
+        for (auto inst : handler->instances())
+        {
+            auto cell_name = handler->name(handler->libraryCell(inst));
+            CHECK(cell_name != "NAND2_X1");
+            CHECK(cell_name != "AND2_X1");
+        }
+        auto out_driver = handler->faninPin(handler->net("o"));
+        REQUIRE(out_driver != nullptr);
+        auto out_inst = handler->instance(out_driver);
+        REQUIRE(out_inst != nullptr);
+        CHECK(handler->isBuffer(handler->libraryCell(out_inst)));
+        CHECK(handler->net(handler->inputPins(out_inst)[0]) ==
+              handler->net("x"));
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
 } // namespace psn
\ No newline at end of file
@@ -60,4 +60,34 @@ TEST_CASE("testing load-driven gate_clone")
     }
 }
 
+TEST_CASE("testing gate_clone parallel planning is deterministic")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        std::vector<int>    clone_counts;
+        std::vector<size_t> instance_counts;
+        for (int run = 0; run < 2; run++)
+        {
+            psn_inst.clearDatabase();
+            psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                             "NangateOpenCellLibrary_typical.lib");
+            psn_inst.readLef("../tests/data/libraries/Nangate45/"
+                             "NangateOpenCellLibrary.mod.lef");
+            psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+            psn_inst.setWireRC(0.0020, 0.00020);
+            clone_counts.push_back(psn_inst.runTransform(
+                "gate_clone", std::vector<std::string>({"1.4", "false"})));
+            instance_counts.push_back(psn_inst.handler()->instances().size());
+        }
+        CHECK(clone_counts[0] >= 0);
+        CHECK(clone_counts[0] == clone_counts[1]);
+        CHECK(instance_counts[0] == instance_counts[1]);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+
 } // namespace psn
\ No newline at end of file
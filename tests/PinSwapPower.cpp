@@ -60,4 +60,56 @@ TEST_CASE("testing pin_swap -power transform")
         FAIL(e.what());
     }
 }
-} // namespace psn
\ No newline at end of file
+
+TEST_CASE("testing pin_swap -activity transform")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk"}, 10E-09);
+        float power_before = handler.power();
+        auto  result       = psn_inst.runTransform(
+            "pin_swap", std::vector<std::string>({"-activity"}));
+        CHECK(result > 0);
+        CHECK(handler.power() <= power_before);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+
+TEST_CASE("testing pin_swap -activity keeps failing outputs in place")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk"}, 0.5E-09);
+        float slack_before = handler.worstSlack();
+        float power_before = handler.power();
+        CHECK(slack_before < 0.0);
+        psn_inst.runTransform("pin_swap",
+                              std::vector<std::string>({"-activity"}));
+        CHECK(handler.worstSlack() >= slack_before - 1E-12);
+        CHECK(handler.power() <= power_before);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+} // namespace psn
@@ -30,8 +30,12 @@
 // POSSIBILITY OF SUCH DAMAGE.
 #include "OpenPhySyn/Psn/Psn.hpp"
 #include "PsnException/PsnException.hpp"
+#include "Utils/FileUtils.hpp"
 #include "doctest.h"
 
+#include <fstream>
+#include <zlib.h>
+
 namespace psn
 {
 
@@ -51,4 +55,79 @@ TEST_CASE("testing LEF/DEF parsing")
         FAIL(e.what());
     }
 }
-} // namespace psn
\ No newline at end of file
+
+TEST_CASE("testing multiple LEF parsing")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        std::vector<std::string> lef_paths = {
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef"};
+        CHECK(psn_inst.readLefs(lef_paths) == 1);
+        psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+        CHECK(psn_inst.database()->getChip() != nullptr);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+
+TEST_CASE("testing compressed DEF parsing")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        FileUtils::createDirectoryIfNotExists("../tests/results");
+        std::string def_str =
+            FileUtils::readFile("../tests/data/designs/fanout/fanout_nan.def");
+        gzFile out = gzopen("../tests/results/fanout_nan.def.gz", "wb");
+        REQUIRE(out != nullptr);
+        gzwrite(out, def_str.data(), def_str.size());
+        gzclose(out);
+
+        psn_inst.clearDatabase();
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        CHECK(psn_inst.readDef("../tests/results/fanout_nan.def.gz") == 1);
+        CHECK(psn_inst.database()->getChip() != nullptr);
+        CHECK(psn_inst.database()->getChip()->getBlock()->getInsts().size() >
+              0);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing truncated compressed DEF parsing")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        FileUtils::createDirectoryIfNotExists("../tests/results");
+        std::string def_str =
+            FileUtils::readFile("../tests/data/designs/fanout/fanout_nan.def");
+        gzFile out = gzopen("../tests/results/fanout_nan_full.def.gz", "wb");
+        REQUIRE(out != nullptr);
+        gzwrite(out, def_str.data(), def_str.size());
+        gzclose(out);
+        std::string gz_str =
+            FileUtils::readFile("../tests/results/fanout_nan_full.def.gz");
+        std::ofstream truncated("../tests/results/fanout_nan_truncated.def.gz",
+                                std::ios::binary);
+        truncated << gz_str.substr(0, gz_str.size() / 2);
+        truncated.close();
+
+        psn_inst.clearDatabase();
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        CHECK(psn_inst.readDef(
+                  "../tests/results/fanout_nan_truncated.def.gz") == -1);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+} // namespace psn
@@ -28,11 +28,16 @@
 // CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
+#include "Liberty/LibertyCache.hpp"
 #include "Psn/Psn.hpp"
 #include "PsnException/PsnException.hpp"
+#include "Utils/FileUtils.hpp"
 #include "doctest.h"
 #include "sta/Liberty.hh"
 
+#include <cstdio>
+#include <fstream>
+
 namespace psn
 {
 
@@ -52,4 +57,85 @@ TEST_CASE("testing liberty parsing")
         FAIL(e.what());
     }
 }
-} // namespace psn
\ No newline at end of file
+
+TEST_CASE("testing liberty cache")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        const char* lib_path = "../tests/data/libraries/Nangate45/"
+                               "NangateOpenCellLibrary_typical.lib";
+        std::string cache_dir =
+            FileUtils::joinPath("../tests/results", "liberty_cache");
+        FileUtils::createDirectoryIfNotExists("../tests/results");
+        FileUtils::createDirectoryIfNotExists(cache_dir);
+        for (auto& file : FileUtils::readDirectory(cache_dir))
+        {
+            std::remove(file.c_str());
+        }
+        CHECK(psn_inst.readLib(lib_path, cache_dir.c_str()) == 1);
+        CHECK(FileUtils::readDirectory(cache_dir).size() == 1);
+        CHECK(psn_inst.readLib(lib_path, cache_dir.c_str(), true) == 1);
+        Liberty*                 liberty = psn_inst.liberty();
+        sta::LibertyCellIterator cell_iter(liberty);
+        CHECK(cell_iter.hasNext());
+
+        // Editing the file changes its size and modification time, so the
+        // image of the same path is replaced instead of reused.
+        std::string lib_copy =
+            FileUtils::joinPath("../tests/results", "liberty_cache_copy.lib");
+        {
+            std::ofstream out(lib_copy);
+            out << FileUtils::readFile(lib_path);
+        }
+        CHECK(psn_inst.readLib(lib_copy.c_str(), cache_dir.c_str()) == 1);
+        CHECK(FileUtils::readDirectory(cache_dir).size() == 2);
+        {
+            std::ofstream out(lib_copy, std::ios::app);
+            out << "/* edited */\n";
+        }
+        CHECK(psn_inst.readLib(lib_copy.c_str(), cache_dir.c_str(), true) ==
+              1);
+        CHECK(FileUtils::readDirectory(cache_dir).size() == 2);
+
+        // An edit of the same size within the time stamp granularity keeps
+        // size and mtime, so only the content hash tells the image is stale.
+        LibertyCacheKey before_key, after_key;
+        CHECK(LibertyCache::computeKey(lib_copy.c_str(), before_key));
+        CHECK(LibertyCache::computeContentHash(lib_copy.c_str(), before_key));
+        {
+            std::ofstream out(lib_copy, std::ios::in | std::ios::out);
+            out.seekp(-10, std::ios::end); // "/* edited */" -> "/* Edited */"
+            out << "E";
+        }
+        CHECK(LibertyCache::computeKey(lib_copy.c_str(), after_key));
+        CHECK(LibertyCache::computeContentHash(lib_copy.c_str(), after_key));
+        CHECK(after_key.size == before_key.size);
+        CHECK(after_key.content_hash != before_key.content_hash);
+        CHECK(psn_inst.readLib(lib_copy.c_str(), cache_dir.c_str()) == 1);
+        CHECK(FileUtils::readDirectory(cache_dir).size() == 2);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+
+TEST_CASE("testing multiple liberty parsing")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        std::vector<std::string> lib_paths = {
+            "../tests/data/libraries/Nangate45/"
+            "NangateOpenCellLibrary_typical.lib",
+            "../tests/data/libraries/gscl45nm/gscl45nm.lib"};
+        CHECK(psn_inst.readLibs(lib_paths) == 2);
+        CHECK(psn_inst.liberty() != nullptr);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+} // namespace psn
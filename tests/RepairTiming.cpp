@@ -61,3 +61,115 @@ TEST_CASE("testing repair_timing transform")
         FAIL(e.what());
     }
 }
+
+TEST_CASE("testing region-partitioned repair_timing transform")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        // Planning the trees per region must not change what gets repaired.
+        auto repair = [&](const std::string& partitions) {
+            psn_inst.clearDatabase();
+            psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                             "NangateOpenCellLibrary_typical.lib");
+            psn_inst.readLef("../tests/data/libraries/Nangate45/"
+                             "NangateOpenCellLibrary.mod.lef");
+            psn_inst.readDef(
+                "../tests/data/designs/timing_buffer/ibex_resized.def");
+            psn_inst.setWireRC("metal2");
+            psn_inst.handler()->createClock("core_clock", {"clk_i"}, 10E-09);
+            return psn_inst.runTransform(
+                "repair_timing",
+                std::vector<std::string>(
+                    {"-transition_violations", "-capacitance_violations",
+                     "-buffers", "BUF_X4", "-partitions", partitions}));
+        };
+        auto  serial_result = repair("1");
+        auto& handler       = *(psn_inst.handler());
+        auto  serial_violations =
+            handler.maximumTransitionViolations().size() +
+            handler.maximumCapacitanceViolations().size();
+        auto result = repair("4");
+        CHECK(result >= 0);
+        CHECK(result == serial_result);
+        CHECK(handler.maximumTransitionViolations().size() +
+                  handler.maximumCapacitanceViolations().size() ==
+              serial_violations);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+
+TEST_CASE("testing repair_timing checkpoint and resume")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        CHECK(FileUtils::createDirectoryIfNotExists("../tests/results"));
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef(
+            "../tests/data/designs/timing_buffer/ibex_resized.def");
+        psn_inst.setWireRC("metal2");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk_i"}, 10E-09);
+        std::string checkpoint = "../tests/results/repair_timing.ckpt";
+        auto        partial    = psn_inst.runTransform(
+            "repair_timing",
+            std::vector<std::string>({"-transition_violations",
+                                      "-capacitance_violations", "-buffers",
+                                      "BUF_X4", "-max_edits", "3",
+                                      "-checkpoint", checkpoint}));
+        CHECK(partial >= 0);
+        // Whole repairs that would overshoot the edit limit are skipped.
+        CHECK(partial <= 3);
+        CHECK(FileUtils::pathExists(checkpoint));
+        CHECK(FileUtils::pathExists(checkpoint + ".odb"));
+
+        auto resumed = psn_inst.runTransform(
+            "repair_timing",
+            std::vector<std::string>({"-transition_violations",
+                                      "-capacitance_violations", "-buffers",
+                                      "BUF_X4", "-resume", checkpoint}));
+        CHECK(resumed >= partial);
+        auto snapshot_insts =
+            psn_inst.database()->getChip()->getBlock()->getInsts().size();
+
+        // A fresh session resumes from the design snapshot.
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        CHECK(psn_inst.runTransform(
+                  "repair_timing",
+                  std::vector<std::string>(
+                      {"-transition_violations", "-capacitance_violations",
+                       "-buffers", "BUF_X4", "-resume", checkpoint})) >= 0);
+        REQUIRE(psn_inst.database()->getChip() != nullptr);
+        CHECK(psn_inst.database()->getChip()->getBlock()->getInsts().size() >=
+              snapshot_insts);
+
+        // Resuming on top of a different design is rejected.
+        if (resumed > 0)
+        {
+            psn_inst.clearDatabase();
+            psn_inst.readLef("../tests/data/libraries/Nangate45/"
+                             "NangateOpenCellLibrary.mod.lef");
+            psn_inst.readDef(
+                "../tests/data/designs/timing_buffer/ibex_resized.def");
+            CHECK(psn_inst.runTransform(
+                      "repair_timing",
+                      std::vector<std::string>({"-transition_violations",
+                                                "-resume", checkpoint})) ==
+                  -1);
+        }
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
@@ -28,11 +28,22 @@
 // CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "OpenPhySyn/Sta/DatabaseSta.hpp"
 #include "OpenPhySyn/Sta/PathPoint.hpp"
+#include "OpenPhySyn/Sta/TimingSnapshot.hpp"
+#include "opendb/geom.h"
 #include "Psn/Psn.hpp"
 #include "PsnException/PsnException.hpp"
 #include "Utils/FileUtils.hpp"
 #include "doctest.h"
+#include "sta/Corner.hh"
+#include "sta/MinMax.hh"
+#include "sta/StringSet.hh"
 
 namespace psn
 {
@@ -68,4 +79,540 @@ TEST_CASE("testing sta functions")
         FAIL(e.what());
     }
 }
-} // namespace psn
\ No newline at end of file
+TEST_CASE("testing batched pin timing queries")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk"}, 10);
+        std::vector<InstanceTerm*> terms;
+        for (auto& pt : handler.criticalPath())
+        {
+            terms.push_back(pt.pin());
+        }
+        PinTimings timings;
+        handler.pinTimings(terms, timings);
+        auto slacks = handler.worstSlacks(terms);
+        CHECK(timings.slacks.size() == terms.size());
+        CHECK(slacks.size() == terms.size());
+        for (size_t i = 0; i < terms.size(); i++)
+        {
+            CHECK(slacks[i] == doctest::Approx(handler.worstSlack(terms[i])));
+            CHECK(timings.slacks[i] == doctest::Approx(slacks[i]));
+            CHECK(timings.loads[i] ==
+                  doctest::Approx(handler.loadCapacitance(terms[i])));
+            CHECK(timings.slews[i] == doctest::Approx(handler.slew(terms[i])));
+        }
+
+        // A missing pin must not discard the rest of the batch.
+        auto with_missing = terms;
+        with_missing.insert(with_missing.begin(), nullptr);
+        auto missing_slacks = handler.worstSlacks(with_missing);
+        CHECK(missing_slacks.size() == with_missing.size());
+        CHECK(missing_slacks[1] == doctest::Approx(slacks[0]));
+        PinTimings missing_timings;
+        handler.pinTimings(with_missing, missing_timings);
+        CHECK(missing_timings.violations[0] == ElectircalViolation::None);
+        CHECK(missing_timings.slacks[1] == doctest::Approx(slacks[0]));
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing electrical violation index")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        handler.buildViolationIndex();
+        CHECK(handler.hasViolationIndex());
+        size_t violating_drivers = 0;
+        for (auto& pin : handler.levelDriverPins())
+        {
+            auto vio = handler.hasElectricalViolation(pin);
+            CHECK((handler.indexedViolation(pin) == ElectircalViolation::None) ==
+                  (vio == ElectircalViolation::None));
+            if (vio != ElectircalViolation::None)
+            {
+                violating_drivers++;
+            }
+        }
+        auto top = handler.topViolations();
+        CHECK(top.size() == violating_drivers);
+        for (size_t i = 1; i < top.size(); i++)
+        {
+            CHECK(handler.violationSeverity(top[i - 1]) >=
+                  handler.violationSeverity(top[i]));
+        }
+
+        // Downsize every driver on the critical path; the slew changes
+        // spread past the edited nets and the index must follow them.
+        for (auto& pt : handler.criticalPath())
+        {
+            auto inst  = handler.instance(pt.pin());
+            auto cells = handler.equivalentCells(handler.libraryCell(inst));
+            if (!cells.empty())
+            {
+                auto smallest = *std::min_element(
+                    cells.begin(), cells.end(),
+                    [&](LibraryCell* a, LibraryCell* b) -> bool {
+                        return handler.area(a) < handler.area(b);
+                    });
+                handler.replaceInstance(inst, smallest);
+            }
+        }
+        // The index classifies both limits on a net, the live query reports
+        // capacitance only without a transition violation; they agree on
+        // which drivers violate.
+        for (auto& pin : handler.levelDriverPins())
+        {
+            CHECK((handler.indexedViolation(pin) == ElectircalViolation::None) ==
+                  (handler.hasElectricalViolation(pin) ==
+                   ElectircalViolation::None));
+        }
+        handler.clearViolationIndex();
+        CHECK(!handler.hasViolationIndex());
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing incremental design area")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler      = *(psn_inst.handler());
+        float initial_area = handler.area();
+        auto  buffer_cell  = handler.smallestBufferCell();
+        auto  inst = handler.createInstance("psn_area_test", buffer_cell);
+        CHECK(handler.area() ==
+              doctest::Approx(initial_area + handler.area(buffer_cell)));
+        handler.replaceInstance(inst, handler.bufferCells().back());
+        float edited_area = handler.area();
+        handler.resetNetlistCache();
+        CHECK(handler.area() == doctest::Approx(edited_area));
+        handler.del(inst);
+        CHECK(handler.area() == doctest::Approx(initial_area));
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing level-ordered driver cache after buffering")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        CHECK(!handler.levelDriverPins().empty());
+        int index = 0;
+        for (auto& pt : handler.criticalPath())
+        {
+            auto pin_net = handler.net(pt.pin());
+            if (handler.isDriver(pt.pin()) && pin_net)
+            {
+                handler.bufferNet(pin_net, handler.smallestBufferCell(),
+                                  "psn_level_buff_" + std::to_string(index),
+                                  "psn_level_net_" + std::to_string(index),
+                                  Point(0, 0));
+                index++;
+            }
+        }
+        CHECK(index > 0);
+        auto cached_order = handler.levelDriverPins();
+        handler.resetNetlistCache();
+        CHECK(cached_order == handler.levelDriverPins());
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing built-in incremental legalizer")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto&     handler = *(psn_inst.handler());
+        Legalizer no_legalizer;
+        handler.setLegalizer(no_legalizer);
+        auto target      = handler.location(handler.instance("_438_"));
+        auto buffer_cell = handler.smallestBufferCell();
+        auto first  = handler.createInstance("psn_legal_test_1", buffer_cell);
+        auto second = handler.createInstance("psn_legal_test_2", buffer_cell);
+        handler.setLocation(first, target);
+        handler.setLocation(second, target);
+        CHECK(handler.legalize());
+        auto first_loc  = handler.location(first);
+        auto second_loc = handler.location(second);
+        CHECK((first_loc.getX() != target.getX() ||
+               first_loc.getY() != target.getY()));
+        CHECK((first_loc.getX() != second_loc.getX() ||
+               first_loc.getY() != second_loc.getY()));
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing spatial index queries")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        auto  inst    = handler.instance("_438_");
+        auto  loc     = handler.location(inst);
+        auto  nearest = handler.nearestInstances(loc, 1);
+        CHECK(nearest.size() == 1);
+        CHECK(nearest[0] == inst);
+        auto in_region = handler.instancesInRegion(loc.getX(), loc.getY(),
+                                                   loc.getX(), loc.getY());
+        CHECK(std::find(in_region.begin(), in_region.end(), inst) !=
+              in_region.end());
+        // A region inside the cell but away from its origin still finds it.
+        auto inside = handler.location(handler.outputPins(inst)[0]);
+        CHECK((inside.getX() != loc.getX() || inside.getY() != loc.getY()));
+        auto overlaps = handler.instancesInRegion(
+            inside.getX(), inside.getY(), inside.getX(), inside.getY());
+        CHECK(std::find(overlaps.begin(), overlaps.end(), inst) !=
+              overlaps.end());
+
+        Point moved(loc.getX() + 5000, loc.getY() + 5000);
+        handler.setLocation(inst, moved);
+        CHECK(handler.nearestInstances(moved, 1)[0] == inst);
+        auto pin     = handler.outputPins(inst)[0];
+        auto pin_loc = handler.location(pin);
+        auto pins    = handler.pinsInRegion(pin_loc.getX(), pin_loc.getY(),
+                                         pin_loc.getX(), pin_loc.getY());
+        CHECK(std::find(pins.begin(), pins.end(), pin) != pins.end());
+        CHECK(handler.nearestInstances(loc, 10).size() == 10);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing incremental power cache")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk"}, 10E-09);
+        handler.buildPowerCache();
+        CHECK(handler.hasPowerCache());
+        float initial_power = handler.cachedPower();
+        CHECK(initial_power > 0.0);
+
+        auto inst   = handler.instance("_438_");
+        auto buffer = handler.createInstance("psn_power_test",
+                                             handler.smallestBufferCell());
+        handler.connect(handler.net(handler.outputPins(inst)[0]),
+                        handler.inputPins(buffer)[0]);
+        float cached_power = handler.cachedPower();
+        CHECK(cached_power > initial_power);
+        CHECK(handler.instancePower(buffer) > 0.0);
+
+        handler.buildPowerCache();
+        float rebuilt_power = handler.cachedPower();
+        CHECK(std::abs(cached_power - rebuilt_power) <= 0.01 * rebuilt_power);
+
+        // Moving a cell changes the wire loads on all of its nets.
+        psn_inst.setWireRC("metal2");
+        handler.buildPowerCache();
+        auto  loc = handler.location(inst);
+        Point moved(loc.getX() + 50000, loc.getY() + 50000);
+        handler.setLocation(inst, moved);
+        handler.forEachPin(inst, [&](InstanceTerm* pin) {
+            handler.calculateParasitics(handler.net(pin));
+        });
+        cached_power = handler.cachedPower();
+        handler.buildPowerCache();
+        rebuilt_power = handler.cachedPower();
+        CHECK(std::abs(cached_power - rebuilt_power) <= 0.001 * rebuilt_power);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing timing snapshot export")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk"}, 10);
+        std::string snapshot_path = "../tests/results/gcd.timing";
+        int pin_count = psn_inst.writeTimingSnapshot(snapshot_path.c_str());
+        CHECK(pin_count > 0);
+
+        TimingSnapshot snapshot;
+        CHECK(snapshot.open(snapshot_path));
+        CHECK(snapshot.pinCount() == static_cast<uint32_t>(pin_count));
+        CHECK(snapshot.endpointCount() > 0);
+
+        auto     critical_path = handler.criticalPath();
+        auto     endpoint_pin  = critical_path.back().pin();
+        uint32_t endpoint      = snapshot.findPin(handler.name(endpoint_pin));
+        CHECK(endpoint < snapshot.pinCount());
+        auto rise_slacks = snapshot.pinColumn(TimingSnapshot::SlackRise);
+        auto fall_slacks = snapshot.pinColumn(TimingSnapshot::SlackFall);
+        CHECK(std::min(rise_slacks[endpoint], fall_slacks[endpoint]) ==
+              doctest::Approx(handler.worstSlack(endpoint_pin)));
+
+        for (uint32_t i = 0; i < snapshot.endpointCount(); i++)
+        {
+            if (snapshot.endpointPins()[i] != endpoint)
+            {
+                continue;
+            }
+            auto path = snapshot.endpointPath(i);
+            CHECK(path.size() == critical_path.size());
+            for (size_t j = 0; j < path.size() && j < critical_path.size();
+                 j++)
+            {
+                CHECK(std::string(snapshot.pinName(path[j].pin)) ==
+                      handler.name(critical_path[j].pin()));
+                auto slews = snapshot.pinColumn(path[j].is_rise
+                                                    ? TimingSnapshot::SlewRise
+                                                    : TimingSnapshot::SlewFall);
+                CHECK(path[j].slew == slews[path[j].pin]);
+            }
+        }
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing per-corner timing queries")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk"}, 10);
+        CHECK(handler.cornerCount() == 1);
+
+        auto critical_path = handler.criticalPath();
+        auto endpoint_pin  = critical_path.back().pin();
+        CHECK(handler.cornerRequired(endpoint_pin, 0) ==
+              doctest::Approx(handler.required(endpoint_pin)));
+
+        auto driver_port = handler.libraryPin(critical_path[1].pin());
+        CHECK(handler.cornerGateDelay(driver_port, 1E-15F, 0) ==
+              doctest::Approx(handler.gateDelay(driver_port, 1E-15F)));
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing legalization queue with an external legalizer")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto&     handler        = *(psn_inst.handler());
+        int       external_calls = 0;
+        Legalizer external       = [&](int) {
+            external_calls++;
+            return true;
+        };
+        handler.setLegalizer(external);
+        auto target = handler.location(handler.instance("_438_"));
+        auto inst   = handler.createInstance("psn_legal_test_ext",
+                                           handler.smallestBufferCell());
+        handler.setLocation(inst, target);
+        CHECK(handler.legalize());
+        CHECK(external_calls == 1);
+
+        // Moves made while the external legalizer was active are not queued
+        // for the built-in one.
+        Legalizer no_legalizer;
+        handler.setLegalizer(no_legalizer);
+        CHECK(handler.legalize());
+        CHECK(handler.location(inst).getX() == target.getX());
+        CHECK(handler.location(inst).getY() == target.getY());
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing two-corner timing queries and buffering")
+{
+    Psn& psn_inst = Psn::instance();
+    auto sta      = psn_inst.handler()->sta();
+    try
+    {
+        std::string lib_path = "../tests/data/libraries/Nangate45/"
+                               "NangateOpenCellLibrary_typical.lib";
+        // The slow corner reads a copy of the library whose default operating
+        // conditions scale every cell delay and transition by 1.5.
+        std::string slow_lib_path =
+            "../tests/results/NangateOpenCellLibrary_slow.lib";
+        {
+            std::ifstream     lib_in(lib_path);
+            std::stringstream lib_text;
+            lib_text << lib_in.rdbuf();
+            std::string text = lib_text.str();
+            auto        end  = text.rfind('}');
+            REQUIRE(end != std::string::npos);
+            text.insert(end, "  nom_process : 1.0 ;\n"
+                             "  k_process_cell_rise : 1.0 ;\n"
+                             "  k_process_cell_fall : 1.0 ;\n"
+                             "  k_process_rise_transition : 1.0 ;\n"
+                             "  k_process_fall_transition : 1.0 ;\n"
+                             "  operating_conditions (slow) {\n"
+                             "    process : 1.5 ;\n"
+                             "    temperature : 25.0 ;\n"
+                             "    voltage : 1.1 ;\n"
+                             "  }\n"
+                             "  default_operating_conditions : slow ;\n");
+            std::ofstream lib_out(slow_lib_path);
+            lib_out << text;
+        }
+        psn_inst.clearDatabase();
+        sta::StringSet corner_names;
+        corner_names.insert("fast");
+        corner_names.insert("slow");
+        sta->makeCorners(&corner_names);
+        auto fast_corner = sta->findCorner("fast");
+        auto slow_corner = sta->findCorner("slow");
+        REQUIRE(fast_corner);
+        REQUIRE(slow_corner);
+        sta->setCmdCorner(fast_corner);
+        psn_inst.readLib(lib_path.c_str());
+        sta->readLiberty(slow_lib_path.c_str(), slow_corner,
+                         sta::MinMaxAll::all(), false);
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/gcd/gcd.def");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk"}, 0.5);
+        CHECK(handler.cornerCount() == 2);
+
+        int  fast = fast_corner->index();
+        int  slow = slow_corner->index();
+        auto critical_path = handler.criticalPath();
+        auto endpoint_pin  = critical_path.back().pin();
+        auto driver_pin    = critical_path[1].pin();
+        CHECK(handler.cornerArrival(driver_pin, slow) >
+              handler.cornerArrival(driver_pin, fast));
+        CHECK(handler.cornerArrival(endpoint_pin, slow) >
+              handler.cornerArrival(endpoint_pin, fast));
+
+        // makeCorners() freed the "default" corner; command-corner queries
+        // must follow the new corners instead of dangling.
+        float load_cap = handler.loadCapacitance(driver_pin);
+        CHECK(load_cap > 0);
+        CHECK(handler.gateDelay(driver_pin, load_cap) > 0);
+        CHECK(handler.power() > 0);
+        CHECK(handler.worstSlack() < 0.5);
+        for (auto pin : handler.maximumTransitionViolations())
+        {
+            CHECK(handler.hasElectricalViolation(pin) !=
+                  ElectircalViolation::None);
+        }
+        for (auto pin : handler.maximumCapacitanceViolations())
+        {
+            CHECK(handler.hasElectricalViolation(pin) !=
+                  ElectircalViolation::None);
+        }
+
+        auto corner_slack = [&](const sta::Corner* corner) {
+            sta::Slack   worst_slack;
+            sta::Vertex* worst_vertex;
+            sta->worstSlack(corner, sta::MinMax::max(), worst_slack,
+                            worst_vertex);
+            return worst_slack;
+        };
+        psn_inst.setWireRC(0.0020, 0.00020);
+        float slow_slack = corner_slack(slow_corner);
+        CHECK(slow_slack < corner_slack(fast_corner));
+
+        // The trees are chosen at the corner they are worst in, which is the
+        // slow one even though timing reports use the fast command corner.
+        auto result = psn_inst.runTransform(
+            "timing_buffer", std::vector<std::string>({"-buffers", "BUF_X4"}));
+        CHECK(result > 0);
+        CHECK(corner_slack(slow_corner) > slow_slack);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+    sta::StringSet default_names;
+    default_names.insert("default");
+    sta->makeCorners(&default_names);
+}
+} // namespace psn
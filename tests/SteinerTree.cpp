@@ -29,6 +29,8 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 #include "OpenPhySyn/Optimize/SteinerTree.hpp"
+#include <thread>
+#include <vector>
 #include "Psn/Psn.hpp"
 #include "PsnException/PsnException.hpp"
 #include "Utils/FileUtils.hpp"
@@ -61,4 +63,69 @@ TEST_CASE("testing steiner tree construction")
         FAIL(e.what());
     }
 }
+TEST_CASE("testing concurrent steiner tree construction")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+        auto& handler = *(psn_inst.handler());
+        auto  net     = handler.net("clk");
+        REQUIRE(net != nullptr);
+        // The clock net is above the largest LUT degree, so every worker
+        // reads the highest degree tables.
+        auto pins = handler.connectedPins(net);
+        auto tree = SteinerTree::create(net, pins, &psn_inst, 3);
+        REQUIRE(tree != nullptr);
+        std::vector<float>       lengths(8, 0.0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < lengths.size(); t++)
+        {
+            threads.push_back(std::thread([&, t]() {
+                auto worker_tree = SteinerTree::create(net, pins, &psn_inst, 3);
+                lengths[t]       = worker_tree ? worker_tree->wirelength() : 0;
+            }));
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (auto& length : lengths)
+        {
+            CHECK(length == tree->wirelength());
+        }
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+TEST_CASE("testing flute LUT image")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        FileUtils::createDirectoryIfNotExists("../tests/results");
+        std::string image_path = "../tests/results/flute.lut";
+        CHECK(Flute::writeLUTImage(image_path.c_str()));
+        CHECK(Flute::readLUTImage(image_path.c_str()));
+        // Reading it again replaces the mapped tables.
+        CHECK(Flute::readLUTImage(image_path.c_str()));
+        psn_inst.clearDatabase();
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+        auto net = psn_inst.handler()->net("clk");
+        CHECK(net != nullptr);
+        auto tree = SteinerTree::create(net, &psn_inst, 3);
+        CHECK(tree->branchCount() == 18);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
 } // namespace psn
\ No newline at end of file
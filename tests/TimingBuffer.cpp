@@ -61,3 +61,30 @@ TEST_CASE("testing timing_buffer transform")
         FAIL(e.what());
     }
 }
+
+TEST_CASE("testing timing_buffer transform with an edit budget")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef(
+            "../tests/data/designs/timing_buffer/ibex_resized.def");
+        psn_inst.setWireRC("metal2");
+        auto& handler = *(psn_inst.handler());
+        handler.createClock("core_clock", {"clk_i"}, 10E-09);
+        auto result = psn_inst.runTransform(
+            "timing_buffer", std::vector<std::string>(
+                                 {"-buffers", "BUF_X4", "-max_edits", "5"}));
+        CHECK(result > 0);
+        CHECK(result <= 5);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
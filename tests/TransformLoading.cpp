@@ -0,0 +1,111 @@
+// BSD 3-Clause License
+
+// Copyright (c) 2019, SCALE Lab, Brown University
+// All rights reserved.
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include "OpenPhySyn/Transform/TransformInfo.hpp"
+#include "Psn/Psn.hpp"
+#include "Transform/PsnTransform.hpp"
+#include "Transform/TransformManifest.hpp"
+#include "Utils/FileUtils.hpp"
+#include "doctest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace psn
+{
+
+TEST_CASE("testing transform manifest")
+{
+    std::string dir =
+        FileUtils::joinPath("../tests/results", "transform_manifest");
+    FileUtils::createDirectoryIfNotExists("../tests/results");
+    FileUtils::createDirectoryIfNotExists(dir);
+    std::remove(
+        FileUtils::joinPath(dir, TransformManifest::fileName()).c_str());
+    std::string plugin = FileUtils::joinPath(dir, "libpin_swap.so");
+    {
+        std::ofstream out(plugin);
+        out << "plugin";
+    }
+
+    TransformManifest manifest(dir);
+    CHECK(!manifest.read());
+    CHECK(manifest.find(plugin) == nullptr);
+    manifest.update(plugin, TransformInfo("pin_swap", "pin_swap\t[-power]\n",
+                                          "1.0.0", "Swap commutative pins"));
+    CHECK(manifest.isModified());
+    CHECK(manifest.write());
+    CHECK(!manifest.isModified());
+
+    TransformManifest indexed(dir);
+    CHECK(indexed.read());
+    auto info = indexed.find(plugin);
+    REQUIRE(info != nullptr);
+    CHECK(info->name() == "pin_swap");
+    CHECK(info->help() == "pin_swap\t[-power]\n");
+    CHECK(info->version() == "1.0.0");
+    CHECK(info->description() == "Swap commutative pins");
+
+    // A plugin rebuilt since it was indexed has to be loaded again.
+    {
+        std::ofstream out(plugin, std::ios::app);
+        out << " rebuilt";
+    }
+    CHECK(indexed.find(plugin) == nullptr);
+    indexed.update(plugin, TransformInfo("pin_swap"));
+    CHECK(indexed.find(plugin) != nullptr);
+
+    // Entries of plugins removed from the directory are dropped.
+    indexed.retain({});
+    CHECK(indexed.isModified());
+    CHECK(indexed.write());
+    TransformManifest emptied(dir);
+    CHECK(emptied.read());
+    CHECK(emptied.find(plugin) == nullptr);
+}
+
+TEST_CASE("testing statically linked transforms")
+{
+    auto builtins = staticTransforms();
+#ifdef OPENPHYSYN_STATIC_TRANSFORMS_ENABLED
+    CHECK(builtins.size() > 0);
+#else
+    CHECK(builtins.empty());
+#endif
+    Psn& psn_inst = Psn::instance();
+    for (auto& builtin : builtins)
+    {
+        CHECK(std::string(builtin.name).size() > 0);
+        CHECK(psn_inst.hasTransform(builtin.name));
+        CHECK(builtin.load() != nullptr);
+    }
+}
+} // namespace psn
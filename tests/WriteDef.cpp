@@ -29,9 +29,14 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 #include "OpenPhySyn/Psn/Psn.hpp"
+#include "OpenPhySyn/Sta/DatabaseStaNetwork.hpp"
 #include "PsnException/PsnException.hpp"
 #include "Utils/FileUtils.hpp"
 #include "doctest.h"
+#include "opendb/db.h"
+
+#include <algorithm>
+#include <fstream>
 
 namespace psn
 {
@@ -57,4 +62,167 @@ TEST_CASE("testing writing DEF files")
         FAIL(e.what());
     }
 }
-} // namespace psn
\ No newline at end of file
+
+TEST_CASE("testing writing and applying ECO files")
+{
+    Psn&             psn_inst = Psn::instance();
+    DatabaseHandler& handler  = *(psn_inst.handler());
+    try
+    {
+        FileUtils::createDirectoryIfNotExists("../tests/results");
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+        CHECK(handler.ecoChanges().modified_nets.empty());
+
+        auto buffer_cell = handler.libraryCell("BUF_X1");
+        REQUIRE(buffer_cell != nullptr);
+        auto inst = handler.createInstance("eco_buffer", buffer_cell);
+        auto net  = handler.createNet("eco_net");
+        handler.setLocation(inst, Point(1000, 1000));
+        handler.connect(net, handler.outputPins(inst)[0]);
+        // Names with spaces, quotes and backslashes are quoted in the file.
+        auto odd_inst =
+            handler.createInstance("eco \"odd\" buf\\[0\\]", buffer_cell);
+        auto odd_net = handler.createNet("eco odd net");
+        handler.setLocation(odd_inst, Point(2000, 2000));
+        handler.connect(odd_net, handler.outputPins(odd_inst)[0]);
+        CHECK(psn_inst.writeEco("../tests/results/fanout_nan.eco") == 4);
+
+        psn_inst.clearDatabase();
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+        CHECK(handler.instance("eco_buffer") == nullptr);
+        CHECK(psn_inst.readEco("../tests/results/fanout_nan.eco") == 4);
+        inst = handler.instance("eco_buffer");
+        REQUIRE(inst != nullptr);
+        CHECK(handler.location(inst).getX() == 1000);
+        CHECK(handler.net(handler.outputPins(inst)[0]) ==
+              handler.net("eco_net"));
+        odd_inst = handler.instance("eco \"odd\" buf\\[0\\]");
+        REQUIRE(odd_inst != nullptr);
+        CHECK(handler.location(odd_inst).getX() == 2000);
+        CHECK(handler.net(handler.outputPins(odd_inst)[0]) ==
+              handler.net("eco odd net"));
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+
+TEST_CASE("testing legalization moves in ECO files")
+{
+    Psn&             psn_inst = Psn::instance();
+    DatabaseHandler& handler  = *(psn_inst.handler());
+    try
+    {
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/complex_propagation/"
+                         "complex_propagation.def");
+        auto buffer_cell = handler.libraryCell("BUF_X1");
+        REQUIRE(buffer_cell != nullptr);
+        auto inst = handler.createInstance("off_site_buffer", buffer_cell);
+        handler.setLocation(inst, Point(20141, 22401));
+        handler.clearEcoChanges();
+        handler.legalize();
+        // The legalizer snapped the buffer to a site, which is a move the ECO
+        // has to replay.
+        CHECK(handler.location(inst).getX() != 20141);
+        CHECK(handler.ecoChanges().modified_instances.count("off_site_buffer"));
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+
+TEST_CASE("testing asynchronous database export")
+{
+    Psn& psn_inst = Psn::instance();
+    try
+    {
+        FileUtils::createDirectoryIfNotExists("../tests/results");
+        psn_inst.clearDatabase();
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+        int inst_count =
+            psn_inst.database()->getChip()->getBlock()->getInsts().size();
+        CHECK(psn_inst.writeDatabase("../tests/results/fanout_nan.odb.gz",
+                                     true, true) == 1);
+        CHECK(psn_inst.waitDatabaseWrite() == 1);
+        CHECK(psn_inst.databaseWriteStatus() == "done");
+
+        psn_inst.clearDatabase();
+        CHECK(psn_inst.readDatabase("../tests/results/fanout_nan.odb.gz") ==
+              1);
+        CHECK(psn_inst.database()->getChip()->getBlock()->getInsts().size() ==
+              inst_count);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+
+TEST_CASE("testing ECO placement records keep orientation and status")
+{
+    Psn&             psn_inst = Psn::instance();
+    DatabaseHandler& handler  = *(psn_inst.handler());
+    try
+    {
+        FileUtils::createDirectoryIfNotExists("../tests/results");
+        psn_inst.clearDatabase();
+        psn_inst.readLib("../tests/data/libraries/Nangate45/"
+                         "NangateOpenCellLibrary_typical.lib");
+        psn_inst.readLef(
+            "../tests/data/libraries/Nangate45/NangateOpenCellLibrary.mod.lef");
+        psn_inst.readDef("../tests/data/designs/fanout/fanout_nan.def");
+        {
+            std::ofstream eco("../tests/results/fixed_buffer.eco");
+            eco << "PSN_ECO 2\n"
+                << "INST fixed_buffer BUF_X1 3001 3001 FS FIXED\n"
+                << "END\n";
+        }
+        // Index the design first so the ECO has to keep the index current.
+        handler.buildSpatialIndex();
+        CHECK(psn_inst.readEco("../tests/results/fixed_buffer.eco") == 1);
+        auto inst = handler.instance("fixed_buffer");
+        REQUIRE(inst != nullptr);
+        auto db_inst = handler.network()->staToDb(inst);
+        CHECK(db_inst->getOrient() == odb::dbOrientType::MX);
+        CHECK(db_inst->getPlacementStatus() == odb::dbPlacementStatus::FIXED);
+
+        // Pin locations cached while applying the record match the ones
+        // computed from scratch for the final orientation.
+        auto  out_pin   = handler.outputPins(inst)[0];
+        Point cached    = handler.location(out_pin);
+        auto  in_region = handler.pinsInRegion(cached.getX(), cached.getY(),
+                                              cached.getX(), cached.getY());
+        CHECK(std::find(in_region.begin(), in_region.end(), out_pin) !=
+              in_region.end());
+        handler.resetNetlistCache();
+        Point fresh = handler.location(out_pin);
+        CHECK(cached.getX() == fresh.getX());
+        CHECK(cached.getY() == fresh.getY());
+
+        // A fixed record is not handed to the row legalizer.
+        handler.legalize();
+        CHECK(handler.location(inst).getX() == 3001);
+        CHECK(handler.location(inst).getY() == 3001);
+    }
+    catch (PsnException& e)
+    {
+        FAIL(e.what());
+    }
+}
+} // namespace psn